@@ -95,6 +95,11 @@ namespace zappy {
                  */
                 void addTeam(const std::string &teamName) { this->_teams.push_back(teamName); }
 
+                /**
+                 * @brief Oublie toutes les équipes connues.
+                 */
+                void clearTeams() { this->_teams.clear(); }
+
                 /**
                  * @brief Ajoute un œuf au jeu.
                  * @param eggId Identifiant de l'œuf.
@@ -21,6 +21,10 @@ zappy::gui::Gui::Gui() :
     _debug(false),
     _ip(defaultIp),
     _port(4242),
+    _recordPath(""),
+    _playbackPath(""),
+    _playbackSpeed(1),
+    _playbackStart(0),
     _protocol(nullptr),
     _gameState(nullptr),
     _renderer(nullptr)
@@ -37,10 +41,10 @@ zappy::gui::Gui::Gui() :
 void zappy::gui::Gui::parseArgs(int argc, char const *argv[])
 {
     if (argc < 3)
-        throw ParsingError("Not enough arguments\n\tUsage: ./zappy_gui -p port -h host", "Parsing");
+        throw ParsingError("Not enough arguments\n\tUsage: ./zappy_gui -p port -h host [-record file] | -play file [-speed x] [-seek ms]", "Parsing");
 
     if (argc == 2 && (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h")) {
-        std::cout << "Usage: ./zappy_gui -p port -h host" << std::endl;
+        std::cout << "Usage: ./zappy_gui -p port -h host [-record file] | -play file [-speed x] [-seek ms]" << std::endl;
         exit(0);
     }
 
@@ -63,6 +67,26 @@ void zappy::gui::Gui::parseArgs(int argc, char const *argv[])
             this->_debug = true;
         } else if (arg == "-raylib" || arg == "-r") {
             raylib = true;
+        } else if (arg == "-record") {
+            if (i + 1 >= argc)
+                throw ParsingError("Missing value for -record", "Parsing");
+            this->_recordPath = argv[++i];
+        } else if (arg == "-play") {
+            if (i + 1 >= argc)
+                throw ParsingError("Missing value for -play", "Parsing");
+            this->_playbackPath = argv[++i];
+        } else if (arg == "-speed") {
+            if (i + 1 >= argc)
+                throw ParsingError("Missing value for -speed", "Parsing");
+            std::istringstream ss(argv[++i]);
+            if (!(ss >> this->_playbackSpeed) || this->_playbackSpeed <= 0)
+                throw ParsingError("Invalid playback speed: " + std::string(argv[i]), "Parsing");
+        } else if (arg == "-seek") {
+            if (i + 1 >= argc)
+                throw ParsingError("Missing value for -seek", "Parsing");
+            std::istringstream ss(argv[++i]);
+            if (!(ss >> this->_playbackStart) || this->_playbackStart < 0)
+                throw ParsingError("Invalid playback position: " + std::string(argv[i]), "Parsing");
         } else
             throw ParsingError("Unknown option: " + arg, "Parsing");
     }
@@ -71,6 +95,8 @@ void zappy::gui::Gui::parseArgs(int argc, char const *argv[])
         throw ParsingError("Host (-h) not specified", "Parsing");
     if (this->_port <= 0 || this->_port > 65535)
         throw ParsingError("Port out of range: " + std::to_string(this->_port), "Parsing");
+    if (!this->_playbackPath.empty() && !this->_recordPath.empty())
+        throw ParsingError("-record and -play cannot be used together", "Parsing");
 
     if (!raylib && this->_debug) {
         this->_renderer = std::make_shared<DebugRenderer>();
@@ -102,14 +128,21 @@ void zappy::gui::Gui::init()
 /**
  * @brief initialize the network
  *
- * initialize the network and send the first request to the server
+ * initialize the network and send the first request to the server,
+ * or open the recording when -play is given
  * initialize the renderer requests to the server
  */
 void zappy::gui::Gui::_initNetwork()
 {
     this->_protocol = std::make_unique<network::Protocol>(this->_renderer, this->_gameState, this->_debug);
-    if (!this->_protocol->connectToServer(this->_ip, this->_port))
-        throw network::NetworkError("Connection failed", "Network");
+    if (!this->_playbackPath.empty()) {
+        this->_protocol->openPlayback(this->_playbackPath, this->_playbackSpeed, this->_playbackStart);
+    } else {
+        if (!this->_protocol->connectToServer(this->_ip, this->_port))
+            throw network::NetworkError("Connection failed", "Network");
+        if (!this->_recordPath.empty())
+            this->_protocol->startRecording(this->_recordPath);
+    }
 
     const ProtocolRequest protocolRequests = {
         { network::GP::MAP_SIZE, [this](const int &, const int &){ this->_protocol->requestMapContent(); } },
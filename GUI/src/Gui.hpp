@@ -46,6 +46,11 @@ namespace zappy {
                 std::string _ip;
                 size_t _port;
 
+                std::string _recordPath;
+                std::string _playbackPath;
+                double _playbackSpeed;
+                int64_t _playbackStart;
+
                 std::unique_ptr<network::Protocol> _protocol;
                 std::shared_ptr<game::GameState> _gameState;
                 std::shared_ptr<IRenderer> _renderer;
@@ -88,6 +88,14 @@ namespace zappy {
                  */
                 void setMessageCallback(std::function<void(const ServerMessage &)> callback);
 
+                /**
+                 * @brief Parse un message brut en structure ServerMessage.
+                 * 
+                 * @param raw Message brut à analyser.
+                 * @return Structure ServerMessage extraite.
+                 */
+                static ServerMessage parseMessage(const std::string &raw);
+
             private:
                 int _socket; ///< Descripteur de socket.
                 bool _connected; ///< Indique si une connexion est active.
@@ -96,14 +104,6 @@ namespace zappy {
                 std::function<void(const ServerMessage &)> _messageCallback; ///< Callback de message.
                 mutable std::mutex _mutex; ///< Mutex pour la synchronisation des accès concurrents.
 
-                /**
-                 * @brief Parse un message brut en structure ServerMessage.
-                 * 
-                 * @param raw Message brut à analyser.
-                 * @return Structure ServerMessage extraite.
-                 */
-                ServerMessage parseMessage(const std::string &raw);
-
                 /**
                  * @brief Traite le tampon interne pour extraire les messages complets.
                  */
@@ -15,13 +15,17 @@ zappy::network::Protocol::Protocol(
     _network(std::make_unique<NetworkManager>()),
     _renderer(renderer),
     _gameState(gameState),
-    _authenticated(false)
+    _authenticated(false),
+    _recorder(nullptr),
+    _playback(nullptr)
 {
     initHandlers();
     initHandlers();
 
     this->_network->setMessageCallback([this](const ServerMessage &msg) {
         printDebug("Received message: " + msg.command + " " + msg.params);
+        if (this->_recorder)
+            this->_recorder->recordMessage(msg.raw);
 
         GP cmd = getGuiProtocol(msg.command);
 
@@ -30,6 +34,8 @@ zappy::network::Protocol::Protocol(
         } catch (const std::exception &e) {
             printDebug("Error handling command \"" + msg.command + " " + msg.params + "\": " + e.what(), std::cerr);
         }
+        if (this->_listener)
+            this->_listener(msg);
     });
 }
 
@@ -72,10 +78,102 @@ void zappy::network::Protocol::onServerMessage(const ServerMessage &msg)
     GuiProtocol cmd = getGuiProtocol(msg.command);
     auto it = _handlers.find(cmd);
 
-    if (it != _handlers.end())
-        it->second(msg.params);
-    else
+    if (it == _handlers.end()) {
         printDebug("Unknown command: " + msg.command, std::cerr);
+        return;
+    }
+    try {
+        it->second(msg.params);
+    } catch (const std::exception &e) {
+        printDebug("Error handling command \"" + msg.raw + "\": " + e.what(), std::cerr);
+    }
+}
+
+/**
+ * @brief Record every message received from the server
+ *
+ * The recording can then be replayed with openPlayback.
+ *
+ * @param path path of the recording file
+ */
+void zappy::network::Protocol::startRecording(const std::string &path)
+{
+    this->_recorder = std::make_unique<Recorder>(path);
+}
+
+/**
+ * @brief Be notified of every message received from the server
+ *
+ * The listener is called once the message has been applied to the game
+ * state, so the state already includes it.
+ *
+ * @param listener function called with each message
+ */
+void zappy::network::Protocol::setMessageListener(std::function<void(const ServerMessage &)> listener)
+{
+    this->_listener = std::move(listener);
+}
+
+/**
+ * @brief Replace the server by a recording
+ *
+ * The recorded messages go through the same handlers as live ones,
+ * update() feeds them at the recorded pace multiplied by the speed.
+ *
+ * @param path path of the recording file
+ * @param speed playback speed, 1 for real time
+ * @param startMs position to start from in milliseconds
+ */
+void zappy::network::Protocol::openPlayback(const std::string &path, double speed, int64_t startMs)
+{
+    this->_playback = std::make_unique<Playback>(path);
+    this->_playback->setSpeed(speed);
+    if (startMs > 0)
+        seekPlayback(startMs);
+}
+
+/**
+ * @brief Move the playback to a position
+ *
+ * The current state is cleared, then the closest keyframe before the
+ * position and the messages that follow it are applied.
+ *
+ * @param positionMs position in milliseconds
+ */
+void zappy::network::Protocol::seekPlayback(int64_t positionMs)
+{
+    if (!this->_playback)
+        return;
+
+    auto messages = this->_playback->seek(positionMs);
+
+    resetState();
+    for (const auto &raw : messages)
+        onServerMessage(NetworkManager::parseMessage(raw));
+    printDebug("Playback moved to " + std::to_string(this->_playback->getPosition()) + " ms");
+}
+
+/**
+ * @brief Remove every player, egg and team before a seek
+ *
+ * Goes through the renderer so that it drops its own models too. The
+ * map is kept, its tiles are overwritten by the keyframe.
+ */
+void zappy::network::Protocol::resetState()
+{
+    std::vector<int> playerIds;
+    std::vector<int> eggIds;
+
+    for (const auto &player : this->_gameState->getPlayers())
+        playerIds.push_back(player.getId());
+    for (const auto &egg : this->_gameState->getEggs())
+        eggIds.push_back(egg.getId());
+
+    for (int id : playerIds)
+        this->_renderer->removePlayer(id);
+    for (int id : eggIds)
+        this->_renderer->removeEgg(id);
+    this->_gameState->clearTeams();
 }
 
 bool zappy::network::Protocol::connectToServer(const std::string &host, int port) {
@@ -134,14 +232,24 @@ void zappy::network::Protocol::disconnect() {
 }
 
 bool zappy::network::Protocol::isConnected() const {
+    if (this->_playback)
+        return true;
     return _network->isConnected() && _authenticated;
 }
 
 void zappy::network::Protocol::update() {
+    if (this->_playback) {
+        for (const auto &raw : this->_playback->poll())
+            onServerMessage(NetworkManager::parseMessage(raw));
+        return;
+    }
+
     if (!isConnected())
         return;
 
     auto messages = this->_network->receiveMessages();
+    if (this->_recorder)
+        this->_recorder->update(*this->_gameState);
 }
 
 // Request handlers
@@ -211,6 +319,13 @@ void zappy::network::Protocol::requestTimeUnit()
 
 void zappy::network::Protocol::setTimeUnit(int timeUnit)
 {
+    // during a playback the time unit sets the speed relative to the recorded one
+    if (this->_playback) {
+        if (this->_gameState->getFrequency() > 0 && timeUnit > 0)
+            this->_playback->setSpeed(static_cast<double>(timeUnit) / this->_gameState->getFrequency());
+        return;
+    }
+
     this->_network->sendCommand(
         getGuiProtocol(GuiProtocol::TIME_UNIT_MODIFICATION) + " " + std::to_string(timeUnit)
     );
@@ -236,6 +351,11 @@ void zappy::network::Protocol::handleMapSize(const std::string &params)
 
     iss >> width >> height;
 
+    // a keyframe resends the map size, keep the map and the renderer as they are
+    const auto &map = this->_gameState->getMap();
+    if (map && map->getWidth() == width && map->getHeight() == height)
+        return;
+
     this->_gameState->initMap(width, height);
     this->_renderer->init();
     printDebug("Map size: " + std::to_string(width) + "x" + std::to_string(height));
@@ -9,6 +9,7 @@
 
 #include "GuiProtocol.hpp"
 #include "NetworkManager.hpp"
+#include "Recording.hpp"
 #include "IRenderer.hpp"
 
 #include <memory>
@@ -33,6 +34,11 @@ namespace zappy {
                 bool isConnected() const;
                 void update();
 
+                void startRecording(const std::string &path);
+                void openPlayback(const std::string &path, double speed = 1, int64_t startMs = 0);
+                void seekPlayback(int64_t positionMs);
+                void setMessageListener(std::function<void(const ServerMessage &)> listener);
+
                 void requestMapSize();
                 void requestTileContent(int x, int y);
                 void requestMapContent();
@@ -77,6 +83,7 @@ namespace zappy {
                 void initHandlers();
                 void initRequestsCommands();
                 void onServerMessage(const ServerMessage &msg);
+                void resetState();
 
                 bool _debug;
 
@@ -88,6 +95,10 @@ namespace zappy {
                 using HandlerFunc = std::function<void(const std::string &)>;
                 std::unordered_map<GuiProtocol, HandlerFunc> _handlers;
                 std::unordered_map<GuiProtocol, std::string> _requestsCommands;
+
+                std::unique_ptr<Recorder> _recorder;
+                std::unique_ptr<Playback> _playback;
+                std::function<void(const ServerMessage &)> _listener;
         };
     } // namespace network
 } // namespace zappy
@@ -0,0 +1,160 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Recording.cpp
+*/
+
+#include "Recording.hpp"
+#include "StateMessages.hpp"
+#include "NetworkError.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+static constexpr const char *recordingHeader = "ZAPPYREC 1";
+
+zappy::network::Recorder::Recorder(const std::string &path) :
+    _file(path, std::ios::trunc),
+    _start(std::chrono::steady_clock::now()),
+    _lastKeyframe(_start)
+{
+    if (!this->_file)
+        throw NetworkError("Unable to create recording " + path, "Recording");
+    this->_file << recordingHeader << '\n';
+}
+
+int64_t zappy::network::Recorder::_elapsedMs() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - this->_start).count();
+}
+
+void zappy::network::Recorder::recordMessage(const std::string &raw)
+{
+    this->_file << "E " << this->_elapsedMs() << ' ' << raw << '\n';
+}
+
+/**
+ * @brief Write a keyframe once the interval has elapsed
+ *
+ * Nothing is written before the map is known, the first messages of the
+ * recording describe the whole state anyway.
+ *
+ * @param state current game state
+ */
+void zappy::network::Recorder::update(const game::GameState &state)
+{
+    auto now = std::chrono::steady_clock::now();
+
+    if (!state.getMap() || now - this->_lastKeyframe < keyframeInterval)
+        return;
+
+    auto messages = stateToMessages(state);
+
+    this->_file << "K " << this->_elapsedMs() << ' ' << messages.size() << '\n';
+    for (const auto &message : messages)
+        this->_file << message << '\n';
+    this->_file.flush();
+    this->_lastKeyframe = now;
+}
+
+zappy::network::Playback::Playback(const std::string &path) :
+    _next(0),
+    _position(0),
+    _speed(1),
+    _lastPoll(std::chrono::steady_clock::now())
+{
+    std::ifstream file(path);
+    std::string line;
+
+    if (!file || !std::getline(file, line) || line != recordingHeader)
+        throw NetworkError("Not a zappy recording: " + path, "Playback");
+
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        char kind = 0;
+        int64_t timeMs = 0;
+
+        if (!(iss >> kind >> timeMs))
+            throw NetworkError("Invalid recording line: " + line, "Playback");
+        if (kind == 'E') {
+            std::string raw;
+            iss.get();
+            std::getline(iss, raw);
+            this->_events.push_back({timeMs, raw});
+        } else if (kind == 'K') {
+            size_t count = 0;
+            Keyframe keyframe{timeMs, this->_events.size(), {}};
+
+            iss >> count;
+            keyframe.state.resize(count);
+            for (auto &message : keyframe.state) {
+                if (!std::getline(file, message))
+                    throw NetworkError("Truncated keyframe in " + path, "Playback");
+            }
+            this->_keyframes.push_back(std::move(keyframe));
+        } else
+            throw NetworkError("Invalid recording line: " + line, "Playback");
+    }
+}
+
+void zappy::network::Playback::setSpeed(double speed)
+{
+    this->poll();
+    if (speed > 0)
+        this->_speed = speed;
+}
+
+int64_t zappy::network::Playback::getDuration() const
+{
+    return this->_events.empty() ? 0 : this->_events.back().timeMs;
+}
+
+std::vector<std::string> zappy::network::Playback::poll()
+{
+    auto now = std::chrono::steady_clock::now();
+    std::vector<std::string> messages;
+
+    this->_position += std::chrono::duration<double, std::milli>(now - this->_lastPoll).count() * this->_speed;
+    this->_lastPoll = now;
+
+    while (this->_next < this->_events.size() && this->_events[this->_next].timeMs <= this->_position) {
+        messages.push_back(this->_events[this->_next].raw);
+        this->_next += 1;
+    }
+    return messages;
+}
+
+/**
+ * @brief Move the playback to a position
+ *
+ * Starts from the last keyframe at or before the position, or from the
+ * beginning of the recording when there is none, and appends the events
+ * received between that point and the position.
+ *
+ * @param positionMs position in milliseconds, clamped to the recording
+ * @return messages to apply on an empty state
+ */
+std::vector<std::string> zappy::network::Playback::seek(int64_t positionMs)
+{
+    std::vector<std::string> messages;
+    size_t next = 0;
+
+    positionMs = std::clamp<int64_t>(positionMs, 0, this->getDuration());
+    auto keyframe = std::upper_bound(this->_keyframes.begin(), this->_keyframes.end(), positionMs,
+        [](int64_t position, const Keyframe &frame) { return position < frame.timeMs; });
+    if (keyframe != this->_keyframes.begin()) {
+        --keyframe;
+        messages = keyframe->state;
+        next = keyframe->nextEvent;
+    }
+
+    while (next < this->_events.size() && this->_events[next].timeMs <= positionMs) {
+        messages.push_back(this->_events[next].raw);
+        next += 1;
+    }
+    this->_next = next;
+    this->_position = static_cast<double>(positionMs);
+    this->_lastPoll = std::chrono::steady_clock::now();
+    return messages;
+}
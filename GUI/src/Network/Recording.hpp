@@ -0,0 +1,155 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Recording.hpp
+*/
+
+#pragma once
+
+#include "GameState.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace zappy {
+    namespace network {
+
+        /**
+         * @brief Enregistre les messages reçus du serveur dans un fichier.
+         *
+         * Format texte : "ZAPPYREC 1", puis une ligne par entrée :
+         * - "E <ms> <message>" pour un message reçu du serveur ;
+         * - "K <ms> <n>" pour une image clé, suivie de n messages décrivant
+         *   l'état complet au même instant.
+         * Une image clé est écrite toutes les keyframeInterval, ce qui
+         * permet de se déplacer dans l'enregistrement sans tout rejouer.
+         */
+        class Recorder {
+            public:
+                static constexpr std::chrono::milliseconds keyframeInterval{5000}; ///< Écart entre deux images clés
+
+                /**
+                 * @brief Crée le fichier d'enregistrement.
+                 * @param path Chemin du fichier.
+                 */
+                explicit Recorder(const std::string &path);
+
+                /**
+                 * @brief Ajoute un message reçu du serveur.
+                 * @param raw Message brut, sans retour à la ligne.
+                 */
+                void recordMessage(const std::string &raw);
+
+                /**
+                 * @brief Écrit une image clé si l'intervalle est écoulé.
+                 * @param state État courant du jeu.
+                 */
+                void update(const game::GameState &state);
+
+            private:
+                std::ofstream _file; ///< Fichier d'enregistrement.
+                std::chrono::steady_clock::time_point _start; ///< Début de l'enregistrement.
+                std::chrono::steady_clock::time_point _lastKeyframe; ///< Dernière image clé écrite.
+
+                /**
+                 * @brief Temps écoulé depuis le début de l'enregistrement.
+                 * @return Millisecondes écoulées.
+                 */
+                int64_t _elapsedMs() const;
+        };
+
+        /**
+         * @brief Relit un enregistrement créé par Recorder.
+         *
+         * Le fichier est chargé en entier. Les messages sont rendus au
+         * rythme de l'enregistrement multiplié par la vitesse ; un
+         * déplacement repart de l'image clé précédente puis rejoue les
+         * seuls messages qui la suivent.
+         */
+        class Playback {
+            public:
+                /**
+                 * @brief Charge un enregistrement.
+                 * @param path Chemin du fichier.
+                 * @throw NetworkError si le fichier est illisible ou invalide.
+                 */
+                explicit Playback(const std::string &path);
+
+                /**
+                 * @brief Change la vitesse de lecture.
+                 * @param speed Multiplicateur, 1 pour le temps réel.
+                 */
+                void setSpeed(double speed);
+
+                /**
+                 * @brief Récupère la vitesse de lecture.
+                 * @return Multiplicateur courant.
+                 */
+                double getSpeed() const { return this->_speed; }
+
+                /**
+                 * @brief Récupère la position de lecture.
+                 * @return Millisecondes depuis le début de l'enregistrement.
+                 */
+                int64_t getPosition() const { return static_cast<int64_t>(this->_position); }
+
+                /**
+                 * @brief Récupère la durée de l'enregistrement.
+                 * @return Millisecondes du dernier message.
+                 */
+                int64_t getDuration() const;
+
+                /**
+                 * @brief Indique si tous les messages ont été rendus.
+                 * @return true si la lecture est terminée.
+                 */
+                bool isFinished() const { return this->_next >= this->_events.size(); }
+
+                /**
+                 * @brief Avance la lecture selon le temps écoulé.
+                 * @return Messages devenus dus depuis le dernier appel.
+                 */
+                std::vector<std::string> poll();
+
+                /**
+                 * @brief Se place à une position de l'enregistrement.
+                 *
+                 * Les messages rendus sont à appliquer sur un état vide.
+                 *
+                 * @param positionMs Position visée en millisecondes.
+                 * @return Image clé précédente puis messages jusqu'à la position.
+                 */
+                std::vector<std::string> seek(int64_t positionMs);
+
+            private:
+                /**
+                 * @brief Message enregistré.
+                 */
+                struct Event {
+                    int64_t timeMs; ///< Instant de réception.
+                    std::string raw; ///< Message brut.
+                };
+
+                /**
+                 * @brief Image clé de l'enregistrement.
+                 */
+                struct Keyframe {
+                    int64_t timeMs; ///< Instant de l'image.
+                    size_t nextEvent; ///< Indice du premier message qui la suit.
+                    std::vector<std::string> state; ///< Messages décrivant l'état.
+                };
+
+                std::vector<Event> _events; ///< Messages triés par instant.
+                std::vector<Keyframe> _keyframes; ///< Images clés triées par instant.
+                size_t _next; ///< Indice du prochain message à rendre.
+                double _position; ///< Position de lecture en millisecondes.
+                double _speed; ///< Vitesse de lecture.
+                std::chrono::steady_clock::time_point _lastPoll; ///< Dernier appel à poll.
+        };
+
+    } // namespace network
+} // namespace zappy
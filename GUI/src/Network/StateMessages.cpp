@@ -0,0 +1,85 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** StateMessages.cpp
+*/
+
+#include "StateMessages.hpp"
+#include "GuiProtocol.hpp"
+
+std::string zappy::network::mapSizeMessage(const game::Map &map)
+{
+    return getGuiProtocol(GP::MAP_SIZE) + " " + std::to_string(map.getWidth()) + " " + std::to_string(map.getHeight());
+}
+
+std::string zappy::network::tileMessage(const game::Map &map, size_t x, size_t y)
+{
+    std::string message = getGuiProtocol(GP::TILE_CONTENT) + " " + std::to_string(x) + " " + std::to_string(y);
+    const game::Tile &tile = map.getTile(x, y);
+
+    for (size_t i = 0; i < game::RESOURCE_QUANTITY; ++i)
+        message += " " + std::to_string(tile.getResourceQuantity(static_cast<game::Resource>(i)));
+    return message;
+}
+
+std::string zappy::network::newPlayerMessage(const game::Player &player)
+{
+    return getGuiProtocol(GP::NEW_PLAYER) + " #" + std::to_string(player.getId()) + " " + std::to_string(player.x)
+        + " " + std::to_string(player.y) + " " + std::to_string(static_cast<int>(player.orientation) + 1)
+        + " " + std::to_string(player.level) + " " + player.teamName;
+}
+
+std::string zappy::network::playerPositionMessage(const game::Player &player)
+{
+    return getGuiProtocol(GP::PLAYER_POSITION) + " #" + std::to_string(player.getId()) + " " + std::to_string(player.x)
+        + " " + std::to_string(player.y) + " " + std::to_string(static_cast<int>(player.orientation) + 1);
+}
+
+std::string zappy::network::playerLevelMessage(const game::Player &player)
+{
+    return getGuiProtocol(GP::PLAYER_LEVEL) + " #" + std::to_string(player.getId()) + " " + std::to_string(player.level);
+}
+
+std::string zappy::network::playerInventoryMessage(const game::Player &player)
+{
+    std::string message = getGuiProtocol(GP::PLAYER_INVENTORY) + " #" + std::to_string(player.getId())
+        + " " + std::to_string(player.x) + " " + std::to_string(player.y);
+
+    for (size_t i = 0; i < game::RESOURCE_QUANTITY; ++i)
+        message += " " + std::to_string(player.getInventory().getResourceQuantity(static_cast<game::Resource>(i)));
+    return message;
+}
+
+std::string zappy::network::eggMessage(const game::Egg &egg)
+{
+    return getGuiProtocol(GP::EGG_CREATED) + " #" + std::to_string(egg.getId()) + " #" + std::to_string(egg.getFatherId())
+        + " " + std::to_string(egg.x) + " " + std::to_string(egg.y);
+}
+
+std::vector<std::string> zappy::network::stateToMessages(const game::GameState &state)
+{
+    std::vector<std::string> messages;
+    const auto &map = state.getMap();
+
+    if (!map)
+        return messages;
+
+    messages.reserve(3 + state.getTeams().size() + map->getWidth() * map->getHeight()
+        + state.getPlayers().size() * 2 + state.getEggs().size());
+    messages.push_back(mapSizeMessage(*map));
+    messages.push_back(getGuiProtocol(GP::TIME_UNIT_REQUEST) + " " + std::to_string(state.getFrequency()));
+    for (const auto &team : state.getTeams())
+        messages.push_back(getGuiProtocol(GP::TEAM_NAME) + " " + team);
+    for (size_t y = 0; y < map->getHeight(); ++y) {
+        for (size_t x = 0; x < map->getWidth(); ++x)
+            messages.push_back(tileMessage(*map, x, y));
+    }
+    for (const auto &player : state.getPlayers()) {
+        messages.push_back(newPlayerMessage(player));
+        messages.push_back(playerInventoryMessage(player));
+    }
+    for (const auto &egg : state.getEggs())
+        messages.push_back(eggMessage(egg));
+    return messages;
+}
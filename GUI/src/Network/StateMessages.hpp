@@ -0,0 +1,81 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** StateMessages.hpp
+*/
+
+#pragma once
+
+#include "GameState.hpp"
+
+#include <string>
+#include <vector>
+
+namespace zappy {
+    namespace network {
+
+        /**
+         * @brief Message msz décrivant la taille de la carte.
+         * @param map Carte du jeu.
+         * @return Message sans retour à la ligne.
+         */
+        std::string mapSizeMessage(const game::Map &map);
+
+        /**
+         * @brief Message bct décrivant le contenu d'une case.
+         * @param map Carte du jeu.
+         * @param x Coordonnée x.
+         * @param y Coordonnée y.
+         * @return Message sans retour à la ligne.
+         */
+        std::string tileMessage(const game::Map &map, size_t x, size_t y);
+
+        /**
+         * @brief Message pnw annonçant un joueur.
+         * @param player Joueur à décrire.
+         * @return Message sans retour à la ligne.
+         */
+        std::string newPlayerMessage(const game::Player &player);
+
+        /**
+         * @brief Message ppo donnant la position d'un joueur.
+         * @param player Joueur à décrire.
+         * @return Message sans retour à la ligne.
+         */
+        std::string playerPositionMessage(const game::Player &player);
+
+        /**
+         * @brief Message plv donnant le niveau d'un joueur.
+         * @param player Joueur à décrire.
+         * @return Message sans retour à la ligne.
+         */
+        std::string playerLevelMessage(const game::Player &player);
+
+        /**
+         * @brief Message pin donnant l'inventaire d'un joueur.
+         * @param player Joueur à décrire.
+         * @return Message sans retour à la ligne.
+         */
+        std::string playerInventoryMessage(const game::Player &player);
+
+        /**
+         * @brief Message enw annonçant un œuf.
+         * @param egg Œuf à décrire.
+         * @return Message sans retour à la ligne.
+         */
+        std::string eggMessage(const game::Egg &egg);
+
+        /**
+         * @brief Décrit l'état complet du jeu avec des messages du protocole.
+         *
+         * Les messages (msz, sgt, tna, bct, pnw, pin, enw) reconstruisent
+         * l'état s'ils sont rejoués dans l'ordre sur un état vide.
+         *
+         * @param state État à décrire.
+         * @return Messages sans retour à la ligne, vide si la carte est inconnue.
+         */
+        std::vector<std::string> stateToMessages(const game::GameState &state);
+
+    } // namespace network
+} // namespace zappy
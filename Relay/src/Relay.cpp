@@ -0,0 +1,409 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Relay.cpp
+*/
+
+#include "Relay.hpp"
+#include "GameError.hpp"
+#include "NetworkError.hpp"
+#include "StateMessages.hpp"
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+zappy::relay::Relay::Relay(bool debug) :
+    _debug(debug),
+    _epoll(-1),
+    _listenFd(-1),
+    _gameState(nullptr),
+    _renderer(nullptr),
+    _protocol(nullptr)
+{}
+
+zappy::relay::Relay::~Relay()
+{
+    for (auto &viewer : this->_viewers)
+        ::close(viewer.first);
+    if (this->_listenFd != -1)
+        ::close(this->_listenFd);
+    if (this->_epoll != -1)
+        ::close(this->_epoll);
+}
+
+/**
+ * @brief Connect to the server as a GUI and open the viewers port
+ *
+ * Waits for the map size so that the first viewer already gets a
+ * complete state.
+ *
+ * @param host server address
+ * @param port server port
+ * @param listenPort port opened to the viewers
+ */
+void zappy::relay::Relay::init(const std::string &host, int port, int listenPort)
+{
+    this->_gameState = std::make_shared<game::GameState>();
+    this->_renderer = std::make_shared<RelayRenderer>();
+    this->_renderer->setGameState(this->_gameState);
+
+    this->_protocol = std::make_unique<network::Protocol>(this->_renderer, this->_gameState, this->_debug);
+    if (!this->_protocol->connectToServer(host, port))
+        throw network::NetworkError("Connection failed", "Relay");
+
+    this->_renderer->setProtocolRequests({
+        { network::GP::MAP_CONTENT, [this](const int &, const int &){
+            this->_protocol->requestMapContent();
+            this->_mctPending += 1;
+        } },
+    });
+    this->_protocol->setMessageListener([this](const network::ServerMessage &msg) { _broadcast(msg); });
+
+    while (!this->_gameState->getMap()) {
+        if (!this->_protocol->isConnected())
+            throw network::NetworkError("Connection lost before the map size", "Relay");
+        this->_protocol->update();
+    }
+
+    _listen(listenPort);
+}
+
+void zappy::relay::Relay::_listen(int port)
+{
+    struct sockaddr_in address = {};
+    struct epoll_event event = {};
+    int option = 1;
+
+    this->_listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (this->_listenFd == -1)
+        throw network::NetworkError("Unable to create the listening socket", "Relay");
+    ::setsockopt(this->_listenFd, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option));
+
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = INADDR_ANY;
+    address.sin_port = htons(port);
+    if (::bind(this->_listenFd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) == -1
+        || ::listen(this->_listenFd, backlog) == -1)
+        throw network::NetworkError("Unable to listen on port " + std::to_string(port), "Relay");
+
+    this->_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+    if (this->_epoll == -1)
+        throw network::NetworkError("Unable to create the epoll instance", "Relay");
+    event.events = EPOLLIN;
+    event.data.fd = this->_listenFd;
+    if (::epoll_ctl(this->_epoll, EPOLL_CTL_ADD, this->_listenFd, &event) == -1)
+        throw network::NetworkError("Unable to watch the listening socket", "Relay");
+}
+
+/**
+ * @brief Relay the server feed until the server goes away
+ *
+ * The viewers are served by epoll, the server connection is polled
+ * between two waits like in the GUI main loop.
+ */
+void zappy::relay::Relay::run()
+{
+    struct epoll_event events[maxEvents];
+
+    while (this->_protocol->isConnected()) {
+        int count = ::epoll_wait(this->_epoll, events, maxEvents, 1);
+
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+
+            if (fd == this->_listenFd) {
+                _accept();
+                continue;
+            }
+            auto it = this->_viewers.find(fd);
+            if (it == this->_viewers.end())
+                continue;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                this->_closing.push_back(fd);
+                continue;
+            }
+            if (events[i].events & EPOLLIN)
+                _read(it->second);
+            if (events[i].events & EPOLLOUT)
+                _flush(it->second);
+        }
+
+        this->_protocol->update();
+        this->_renderer->update();
+
+        for (int fd : this->_closing)
+            _close(fd);
+        this->_closing.clear();
+    }
+    std::cerr << "Connection lost" << std::endl;
+}
+
+void zappy::relay::Relay::_accept()
+{
+    int fd = ::accept4(this->_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+    while (fd != -1) {
+        struct epoll_event event = {};
+
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (::epoll_ctl(this->_epoll, EPOLL_CTL_ADD, fd, &event) == -1) {
+            ::close(fd);
+        } else {
+            auto &viewer = this->_viewers[fd];
+            viewer = Viewer{fd, false, false, "", ""};
+            _send(viewer, "WELCOME\n");
+        }
+        fd = ::accept4(this->_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    }
+}
+
+void zappy::relay::Relay::_read(Viewer &viewer)
+{
+    char buffer[4096];
+    ssize_t received = ::recv(viewer.fd, buffer, sizeof(buffer), 0);
+
+    while (received > 0) {
+        viewer.input.append(buffer, received);
+        received = ::recv(viewer.fd, buffer, sizeof(buffer), 0);
+    }
+    if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+        this->_closing.push_back(viewer.fd);
+        return;
+    }
+
+    size_t pos = viewer.input.find('\n');
+    while (pos != std::string::npos) {
+        std::string line = viewer.input.substr(0, pos);
+
+        viewer.input.erase(0, pos + 1);
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        _handleLine(viewer, line);
+        pos = viewer.input.find('\n');
+    }
+}
+
+/**
+ * @brief Handle a line sent by a viewer
+ *
+ * A viewer has to announce itself with GRAPHIC, it then receives the
+ * whole state from memory, the same way the server bootstraps a GUI.
+ *
+ * @param viewer viewer that sent the line
+ * @param line line without the newline
+ */
+void zappy::relay::Relay::_handleLine(Viewer &viewer, const std::string &line)
+{
+    if (!viewer.graphic) {
+        if (line != "GRAPHIC") {
+            _send(viewer, "ko\n");
+            return;
+        }
+        viewer.graphic = true;
+
+        std::string snapshot;
+        for (const auto &message : network::stateToMessages(*this->_gameState))
+            snapshot += message + '\n';
+        _send(viewer, snapshot);
+        return;
+    }
+
+    auto pos = line.find(' ');
+    if (pos == std::string::npos)
+        _answer(viewer, line, "");
+    else
+        _answer(viewer, line.substr(0, pos), line.substr(pos + 1));
+}
+
+/**
+ * @brief Answer a GUI request from the state kept in memory
+ *
+ * Only sst goes up to the server, its answer reaches every viewer
+ * through the live feed. Bad arguments get the same answer as from the
+ * server: ko for bct, ppo, plv and pin, sbp for sst.
+ *
+ * @param viewer viewer that sent the request
+ * @param command request name
+ * @param params request parameters
+ */
+void zappy::relay::Relay::_answer(Viewer &viewer, const std::string &command, const std::string &params)
+{
+    std::string trueParams = params;
+    trueParams.erase(std::remove(trueParams.begin(), trueParams.end(), '#'), trueParams.end());
+    std::istringstream iss(trueParams);
+    const auto &map = this->_gameState->getMap();
+
+    if (command == "msz") {
+        _send(viewer, network::mapSizeMessage(*map) + '\n');
+    } else if (command == "bct") {
+        size_t x;
+        size_t y;
+        std::string leftover;
+
+        if (iss >> x >> y && !(iss >> leftover) && x < map->getWidth() &&
+            y < map->getHeight())
+            _send(viewer, network::tileMessage(*map, x, y) + '\n');
+        else
+            _send(viewer, "ko\n");
+    } else if (command == "mct") {
+        std::string answer;
+
+        for (size_t y = 0; y < map->getHeight(); ++y) {
+            for (size_t x = 0; x < map->getWidth(); ++x)
+                answer += network::tileMessage(*map, x, y) + '\n';
+        }
+        _send(viewer, answer);
+    } else if (command == "tna") {
+        std::string answer;
+
+        for (const auto &team : this->_gameState->getTeams())
+            answer += "tna " + team + '\n';
+        _send(viewer, answer);
+    } else if (command == "ppo" || command == "plv" || command == "pin") {
+        int id = -1;
+
+        iss >> id;
+        try {
+            const game::Player &player = std::as_const(*this->_gameState).getPlayerById(id);
+            if (command == "ppo")
+                _send(viewer, network::playerPositionMessage(player) + '\n');
+            else if (command == "plv")
+                _send(viewer, network::playerLevelMessage(player) + '\n');
+            else
+                _send(viewer, network::playerInventoryMessage(player) + '\n');
+        } catch (const game::GameError &) {
+            _send(viewer, "ko\n");
+        }
+    } else if (command == "sgt") {
+        _send(viewer, "sgt " + std::to_string(this->_gameState->getFrequency()) + '\n');
+    } else if (command == "sst") {
+        int timeUnit = 0;
+
+        if (iss >> timeUnit && timeUnit > 0)
+            this->_protocol->setTimeUnit(timeUnit);
+        else
+            _send(viewer, "sbp\n");
+    } else
+        _send(viewer, "suc\n");
+}
+
+/**
+ * @brief Tell whether a bct line answers one of the relay own mct requests
+ *
+ * The server answers mct with one bct per tile, x by x and y by y, in one
+ * block. A bct matching the next tile of a pending answer belongs to it,
+ * any other one was pushed by the server after a change of the tile.
+ *
+ * @param params parameters of the bct line
+ * @return true if the line must not be forwarded
+ */
+bool zappy::relay::Relay::_isMctAnswer(const std::string &params)
+{
+    const auto &map = this->_gameState->getMap();
+    size_t x = 0;
+    size_t y = 0;
+
+    if (this->_mctPending == 0 || !map || map->getHeight() == 0)
+        return false;
+    std::istringstream iss(params);
+    if (!(iss >> x >> y) || x != this->_mctNext / map->getHeight()
+        || y != this->_mctNext % map->getHeight())
+        return false;
+    this->_mctNext += 1;
+    if (this->_mctNext == map->getWidth() * map->getHeight()) {
+        this->_mctNext = 0;
+        this->_mctPending -= 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Forward a server message to every viewer
+ *
+ * The message is already applied to the game state. Only the answers to
+ * the relay own mct requests are kept back, viewers get the tiles through
+ * their own requests answered from memory.
+ *
+ * @param msg message received from the server
+ */
+void zappy::relay::Relay::_broadcast(const network::ServerMessage &msg)
+{
+    if (msg.command == "bct" && _isMctAnswer(msg.params))
+        return;
+
+    std::string data = msg.raw + '\n';
+    for (auto &viewer : this->_viewers) {
+        if (viewer.second.graphic)
+            _send(viewer.second, data);
+    }
+}
+
+/**
+ * @brief Send data to a viewer without blocking
+ *
+ * What cannot be written now is kept and sent when the socket is
+ * writable again. A viewer too far behind is disconnected.
+ *
+ * @param viewer destination
+ * @param data data to send
+ */
+void zappy::relay::Relay::_send(Viewer &viewer, const std::string &data)
+{
+    bool wasEmpty = viewer.output.empty();
+
+    viewer.output += data;
+    if (!wasEmpty) {
+        if (viewer.output.size() > maxOutput)
+            this->_closing.push_back(viewer.fd);
+        return;
+    }
+    _flush(viewer);
+}
+
+void zappy::relay::Relay::_flush(Viewer &viewer)
+{
+    size_t sent = 0;
+
+    while (sent < viewer.output.size()) {
+        ssize_t written = ::send(viewer.fd, viewer.output.data() + sent, viewer.output.size() - sent, MSG_NOSIGNAL);
+
+        if (written == -1) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                this->_closing.push_back(viewer.fd);
+            break;
+        }
+        sent += written;
+    }
+    viewer.output.erase(0, sent);
+    _watchOutput(viewer, !viewer.output.empty());
+}
+
+void zappy::relay::Relay::_watchOutput(Viewer &viewer, bool enable)
+{
+    struct epoll_event event = {};
+
+    if (viewer.writing == enable)
+        return;
+    viewer.writing = enable;
+    event.events = enable ? EPOLLIN | EPOLLOUT : EPOLLIN;
+    event.data.fd = viewer.fd;
+    ::epoll_ctl(this->_epoll, EPOLL_CTL_MOD, viewer.fd, &event);
+}
+
+void zappy::relay::Relay::_close(int fd)
+{
+    if (this->_viewers.erase(fd) == 0)
+        return;
+    ::epoll_ctl(this->_epoll, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+}
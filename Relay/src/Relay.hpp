@@ -0,0 +1,103 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Relay.hpp
+*/
+
+#pragma once
+
+#include "GameState.hpp"
+#include "Protocol.hpp"
+#include "RelayRenderer.hpp"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace zappy {
+    namespace relay {
+
+        /**
+         * @brief Interface graphique connectée au relais.
+         */
+        struct Viewer {
+            int fd; ///< Socket du spectateur.
+            bool graphic; ///< Le spectateur s'est annoncé avec GRAPHIC.
+            bool writing; ///< EPOLLOUT est surveillé pour ce spectateur.
+            std::string input; ///< Données reçues pas encore découpées en lignes.
+            std::string output; ///< Données en attente d'envoi.
+        };
+
+        /**
+         * @brief Relaie le flux d'un serveur vers de nombreuses interfaces.
+         *
+         * Le relais se connecte une seule fois au serveur comme GRAPHIC et
+         * tient un GameState en mémoire. Un spectateur qui arrive reçoit
+         * l'état complet depuis cette mémoire, puis chaque événement du
+         * serveur ; ses requêtes (msz, bct, mct, tna, ppo, plv, pin, sgt)
+         * sont aussi servies depuis la mémoire, seul sst remonte au
+         * serveur. Le nombre de spectateurs ne pèse donc plus sur le jeu.
+         */
+        class Relay {
+            public:
+                static constexpr size_t maxOutput = 8 * 1024 * 1024; ///< Retard maximal d'un spectateur avant déconnexion
+                static constexpr int maxEvents = 256; ///< Événements epoll traités par tour
+                static constexpr int backlog = 128; ///< File d'attente du socket d'écoute
+
+                /**
+                 * @brief Construit le relais.
+                 * @param debug Affiche les messages du protocole.
+                 */
+                explicit Relay(bool debug = false);
+
+                /**
+                 * @brief Ferme les spectateurs et la connexion au serveur.
+                 */
+                ~Relay();
+
+                /**
+                 * @brief Se connecte au serveur et ouvre le port d'écoute.
+                 * @param host Adresse du serveur.
+                 * @param port Port du serveur.
+                 * @param listenPort Port ouvert aux spectateurs.
+                 * @throw NetworkError si une des deux connexions échoue.
+                 */
+                void init(const std::string &host, int port, int listenPort);
+
+                /**
+                 * @brief Relaie le flux jusqu'à la déconnexion du serveur.
+                 */
+                void run();
+
+            private:
+                void _listen(int port);
+                void _accept();
+                void _read(Viewer &viewer);
+                void _handleLine(Viewer &viewer, const std::string &line);
+                void _answer(Viewer &viewer, const std::string &command, const std::string &params);
+                bool _isMctAnswer(const std::string &params);
+                void _broadcast(const network::ServerMessage &msg);
+                void _send(Viewer &viewer, const std::string &data);
+                void _flush(Viewer &viewer);
+                void _watchOutput(Viewer &viewer, bool enable);
+                void _close(int fd);
+
+                bool _debug;
+                int _epoll;
+                int _listenFd;
+
+                std::shared_ptr<game::GameState> _gameState;
+                std::shared_ptr<gui::IRenderer> _renderer;
+                std::unique_ptr<network::Protocol> _protocol;
+
+                std::unordered_map<int, Viewer> _viewers;
+                std::vector<int> _closing;
+
+                size_t _mctPending = 0; ///< Réponses à mct du relais pas encore reçues.
+                size_t _mctNext = 0; ///< Prochaine case attendue de la réponse en cours.
+        };
+
+    } // namespace relay
+} // namespace zappy
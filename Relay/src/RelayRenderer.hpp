@@ -0,0 +1,33 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** RelayRenderer.hpp
+*/
+
+#pragma once
+
+#include "ARenderer.hpp"
+
+namespace zappy {
+    namespace relay {
+
+        /**
+         * @brief Renderer sans affichage du relais.
+         *
+         * Il ne fait que tenir le GameState à jour à travers ARenderer,
+         * y compris la demande régulière du contenu de la carte.
+         */
+        class RelayRenderer : public gui::ARenderer
+        {
+            public:
+                RelayRenderer() = default;
+                ~RelayRenderer() override = default;
+
+                void handleInput() override {}
+                void render() const override {}
+                bool shouldClose() const override { return false; }
+        };
+
+    } // namespace relay
+} // namespace zappy
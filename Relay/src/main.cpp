@@ -0,0 +1,61 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** main
+*/
+
+#include "Relay.hpp"
+#include "ParsingError.hpp"
+
+#include <iostream>
+#include <sstream>
+
+static constexpr const char *usage = "Usage: ./zappy_relay -p port -h host -l listen_port [-d]";
+
+static int parsePort(const std::string &flag, const char *value)
+{
+    std::istringstream ss(value);
+    int port = 0;
+
+    if (!(ss >> port) || port <= 0 || port > 65535)
+        throw zappy::ParsingError("Invalid port for " + flag + ": " + value, "Parsing");
+    return port;
+}
+
+int main(int argc, char const *argv[])
+{
+    std::string host = "127.0.0.1";
+    int port = 0;
+    int listenPort = 0;
+    bool debug = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if ((arg == "-p" || arg == "-h" || arg == "-l") && i + 1 >= argc)
+                throw zappy::ParsingError("Missing value for " + arg, "Parsing");
+            if (arg == "-p")
+                port = parsePort(arg, argv[++i]);
+            else if (arg == "-l")
+                listenPort = parsePort(arg, argv[++i]);
+            else if (arg == "-h")
+                host = argv[++i];
+            else if (arg == "-d" || arg == "-debug")
+                debug = true;
+            else
+                throw zappy::ParsingError("Unknown option: " + arg, "Parsing");
+        }
+        if (!port || !listenPort)
+            throw zappy::ParsingError(std::string("Not enough arguments\n\t") + usage, "Parsing");
+
+        zappy::relay::Relay relay(debug);
+        relay.init(host, port, listenPort);
+        relay.run();
+    } catch (const zappy::IError &e) {
+        std::cerr << e.where() << " Error: " << e.what() << std::endl;
+        return 84;
+    }
+    return 0;
+}
@@ -12,13 +12,17 @@
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
+#include <string_view>
 #include <sys/socket.h>
 #include <unistd.h>
 #include <vector>
 
+#include "ClientOutput.hpp"
+#include "CommandInbox.hpp"
 #include "Inventory.hpp"
+#include "MessageFormat.hpp"
+#include "NetworkStats.hpp"
 #include "my_macros.hpp"
 
 namespace zappy {
@@ -44,26 +48,21 @@ namespace zappy {
             /**
              * @brief Constructeur avec socket.
              * @param socket Descripteur du socket du client.
+             * @param sink Backend qui envoie les messages, nul pour les
+             * envoyer directement.
              */
-            Client(int socket)
-                : _socket(socket), _state(ClientState::WAITING_TEAM_NAME)
+            Client(int socket, IOutputSink *sink = nullptr)
+                : _socket(socket), _state(ClientState::WAITING_TEAM_NAME),
+                  _sink(sink)
             {
-                this->queueMutex = std::make_unique<std::mutex>();
+                this->_inbox = std::make_shared<CommandInbox>();
+                this->_output = std::make_shared<ClientOutput>();
             };
 
             /**
-             * @brief Destructeur.
-             * Vide la file de messages en protégeant l'accès via un mutex.
+             * @brief Destructeur par défaut.
              */
-            ~Client()
-            {
-                if (queueMutex) {
-                    std::lock_guard<std::mutex> lock(*queueMutex);
-                    while (!queueMessage.empty()) {
-                        queueMessage.pop();
-                    }
-                }
-            }
+            ~Client() = default;
 
             /**
              * @brief Obtient le socket du client.
@@ -87,22 +86,117 @@ namespace zappy {
              * @brief Envoie un message au client via le socket.
              * @param buf Message à envoyer.
              */
-            void sendMessage(const std::string &buf)
+            void sendMessage(std::string_view buf)
+            {
+                this->bufferMessage(buf);
+                this->flushMessages();
+            }
+
+            /**
+             * @brief Ajoute un message au tampon de sortie sans l'envoyer.
+             * Permet de préparer plusieurs messages puis de les envoyer
+             * en un seul appel à flushMessages().
+             * @param buf Message à ajouter.
+             */
+            void bufferMessage(std::string_view buf)
+            {
+                this->bufferFormatted(buf);
+            }
+
+            /**
+             * @brief Formate un message directement dans le tampon de sortie.
+             * @param pieces Chaînes, caractères ou entiers composant le message.
+             */
+            template <typename... Args>
+            void bufferFormatted(const Args &...pieces)
+            {
+                std::lock_guard<std::mutex> lock(this->_output->mutex);
+                formatTo(this->_output->held ? this->_output->deferred
+                                             : this->_output->buffer,
+                    pieces...);
+            }
+
+            /**
+             * @brief Formate un message dans le tampon de sortie puis l'envoie.
+             * @param pieces Chaînes, caractères ou entiers composant le message.
+             */
+            template <typename... Args>
+            void sendFormatted(const Args &...pieces)
+            {
+                this->bufferFormatted(pieces...);
+                this->flushMessages();
+            }
+
+            /**
+             * @brief Envoie tout le contenu du tampon de sortie.
+             * Le tampon est vidé même en cas d'erreur d'envoi. Avec un
+             * backend qui envoie lui-même, le tampon lui est seulement
+             * confié.
+             */
+            void flushMessages()
             {
-                ssize_t bytesSent =
-                    send(this->_socket, buf.c_str(), buf.size(), 0);
-                (void)bytesSent;
+                std::lock_guard<std::mutex> lock(this->_output->mutex);
+                auto &buffer = this->_output->buffer;
+
+                if (!this->_sink)
+                    return sendOutput(this->_socket, buffer);
+                if (!buffer.empty() && !this->_output->scheduled) {
+                    this->_output->scheduled = true;
+                    this->_sink->schedule(this->_socket, this->_output);
+                }
             }
 
-            /// File des messages en attente d'envoi
-            std::queue<std::string> queueMessage;
+            /**
+             * @brief Réserve la place d'un contenu préparé par un autre thread.
+             *
+             * Jusqu'à releaseOutput(), les messages suivants sont mis de
+             * côté : ils partiront après le contenu, dans l'ordre.
+             */
+            void holdOutput()
+            {
+                std::lock_guard<std::mutex> lock(this->_output->mutex);
+
+                this->_output->held = true;
+            }
 
-            /// Mutex pour protéger l'accès à la file de messages
-            std::shared_ptr<std::mutex> queueMutex = nullptr;
+            /**
+             * @brief Indique si un contenu réservé n'est pas encore prêt.
+             * @return bool Vrai entre holdOutput() et releaseOutput().
+             */
+            bool isOutputHeld() const { return this->_output->held; }
+
+            /**
+             * @brief Place le contenu réservé puis envoie la suite.
+             * @param content Contenu préparé, envoyé avant les messages
+             * mis de côté depuis holdOutput().
+             */
+            void releaseOutput(std::string_view content)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(this->_output->mutex);
+
+                    this->_output->buffer.append(content);
+                    this->_output->buffer.append(this->_output->deferred);
+                    this->_output->deferred.clear();
+                    this->_output->held = false;
+                }
+                this->flushMessages();
+            }
+
+            /**
+             * @brief Obtient la file des commandes reçues du client.
+             * @return CommandInbox& File des commandes en attente.
+             */
+            CommandInbox &getInbox() { return *this->_inbox; }
 
            private:
             int _socket;              ///< Socket du client
             ClientState _state;       ///< État actuel du client
+            IOutputSink *_sink;       ///< Backend d'envoi, nul si direct
+            std::shared_ptr<CommandInbox> _inbox =
+                nullptr;  ///< Commandes reçues en attente d'exécution
+            std::shared_ptr<ClientOutput> _output =
+                nullptr;  ///< Tampon de sortie, partagé entre les copies
         };
     }  // namespace server
 }  // namespace zappy
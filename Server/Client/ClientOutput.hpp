@@ -0,0 +1,79 @@
+//
+// EPITECH PROJECT, 2025
+// ClientOutput
+// File description:
+// Output buffer of a client and deferred sending
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/socket.h>
+
+#include "NetworkStats.hpp"
+
+namespace zappy {
+    namespace server {
+
+        /**
+         * @struct ClientOutput
+         * @brief Tampon de sortie d'un client, partagé entre ses copies.
+         */
+        struct ClientOutput {
+            std::mutex mutex;        ///< Protège buffer, scheduled et deferred
+            std::string buffer;      ///< Messages en attente d'envoi
+            bool scheduled = false;  ///< Déjà confié au backend réseau
+            std::atomic<bool> held = false;  ///< Un contenu préparé ailleurs passe avant la suite
+            std::string deferred;    ///< Messages arrivés pendant que held est vrai
+        };
+
+        /**
+         * @class IOutputSink
+         * @brief Backend réseau qui envoie lui-même les tampons de sortie.
+         *
+         * Quand un client en a un, flushMessages() ne fait plus d'appel
+         * système : le tampon est confié au backend, qui l'envoie depuis
+         * le thread réseau avec ceux des autres clients.
+         */
+        class IOutputSink {
+           public:
+            virtual ~IOutputSink() = default;
+
+            /**
+             * @brief Confie un tampon de sortie au backend.
+             *
+             * Appelé au plus une fois tant que scheduled reste vrai, avec
+             * le mutex du tampon verrouillé, depuis n'importe quel thread.
+             * @param socket Socket du client.
+             * @param output Tampon à envoyer.
+             */
+            virtual void schedule(
+                int socket, std::shared_ptr<ClientOutput> output) = 0;
+        };
+
+        /**
+         * @brief Envoie un tampon de sortie puis le vide.
+         *
+         * Le tampon est vidé même en cas d'erreur d'envoi.
+         * @param socket Socket du client.
+         * @param buffer Messages à envoyer.
+         */
+        inline void sendOutput(int socket, std::string &buffer)
+        {
+            size_t offset = 0;
+
+            while (offset < buffer.size()) {
+                ssize_t bytesSent = send(socket, buffer.data() + offset,
+                    buffer.size() - offset, MSG_NOSIGNAL);
+                networkSyscalls.fetch_add(1, std::memory_order_relaxed);
+                if (bytesSent <= 0)
+                    break;
+                offset += static_cast<size_t>(bytesSent);
+            }
+            buffer.clear();
+        }
+    }  // namespace server
+}  // namespace zappy
@@ -0,0 +1,142 @@
+//
+// EPITECH PROJECT, 2025
+// CommandInbox
+// File description:
+// Bounded lock-free command queue of a client
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace zappy {
+    namespace server {
+
+        /**
+         * @class CommandInbox
+         * @brief File bornée et sans verrou des commandes reçues d'un client.
+         *
+         * Plusieurs producteurs (threads réseau) et un seul consommateur
+         * (la boucle de jeu). Chaque case possède son propre stockage de
+         * ligne, aucune allocation n'est faite après la construction.
+         * La capacité correspond à la limite de 10 commandes imposée par
+         * le protocole. La commande en cours d'exécution compte dans cette
+         * limite : sa case n'est libérée qu'au pop() suivant, que la boucle
+         * de jeu n'appelle qu'une fois la commande terminée.
+         */
+        class CommandInbox {
+           public:
+            /// Nombre maximal de commandes en attente ou en cours
+            static constexpr size_t capacity = 10;
+
+            /// Taille maximale d'une ligne de commande
+            static constexpr size_t maxLineSize = 1024;
+
+            /**
+             * @brief Constructeur, toutes les cases sont libres.
+             */
+            CommandInbox()
+            {
+                for (size_t i = 0; i < capacity; i += 1)
+                    this->_slots[i].sequence.store(
+                        i, std::memory_order_relaxed);
+            }
+
+            CommandInbox(const CommandInbox &) = delete;
+            CommandInbox &operator=(const CommandInbox &) = delete;
+
+            /**
+             * @brief Ajoute une ligne (côté producteur).
+             * @param line Commande reçue, sans le '\n' final.
+             * @return false si la file est pleine ou la ligne trop longue.
+             */
+            bool push(std::string_view line)
+            {
+                if (line.size() > maxLineSize)
+                    return false;
+
+                size_t pos = this->_enqueuePos.load(std::memory_order_relaxed);
+                Slot *slot = nullptr;
+
+                while (true) {
+                    slot = &this->_slots[pos % capacity];
+                    size_t seq = slot->sequence.load(std::memory_order_acquire);
+                    auto diff = static_cast<std::ptrdiff_t>(seq) -
+                                static_cast<std::ptrdiff_t>(pos);
+
+                    if (diff == 0) {
+                        if (this->_enqueuePos.compare_exchange_weak(pos,
+                                pos + 1, std::memory_order_relaxed))
+                            break;
+                    } else if (diff < 0) {
+                        return false;
+                    } else {
+                        pos = this->_enqueuePos.load(std::memory_order_relaxed);
+                    }
+                }
+                std::memcpy(slot->line.data(), line.data(), line.size());
+                slot->size = line.size();
+                slot->sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Retire la plus ancienne ligne (côté consommateur).
+             *
+             * Libère d'abord la case de la ligne rendue par l'appel
+             * précédent, dont la commande est terminée.
+             * @param out Chaîne recevant la ligne, sa capacité est réutilisée.
+             * @return false si la file est vide.
+             */
+            bool pop(std::string &out)
+            {
+                size_t pos = this->_dequeuePos;
+                Slot &slot = this->_slots[pos % capacity];
+
+                if (this->_inFlight) {
+                    this->_slots[(pos - 1) % capacity].sequence.store(
+                        pos - 1 + capacity, std::memory_order_release);
+                    this->_inFlight = false;
+                }
+                if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+                    return false;
+                out.assign(slot.line.data(), slot.size);
+                this->_dequeuePos = pos + 1;
+                this->_inFlight = true;
+                return true;
+            }
+
+            /**
+             * @brief Indique si aucune commande n'est en attente.
+             * @return true si la file est vide.
+             */
+            bool empty() const
+            {
+                const Slot &slot = this->_slots[this->_dequeuePos % capacity];
+                return slot.sequence.load(std::memory_order_acquire) !=
+                       this->_dequeuePos + 1;
+            }
+
+           private:
+            /**
+             * @struct Slot
+             * @brief Case de la file avec son stockage de ligne.
+             */
+            struct Slot {
+                std::atomic<size_t> sequence{0};  ///< Numéro de tour
+                size_t size = 0;                  ///< Taille de la ligne
+                std::array<char, maxLineSize> line;  ///< Contenu de la ligne
+            };
+
+            std::array<Slot, capacity> _slots;  ///< Cases de la file
+            std::atomic<size_t> _enqueuePos{0};  ///< Position d'écriture
+            size_t _dequeuePos = 0;  ///< Position de lecture (consommateur)
+            bool _inFlight = false;  ///< Case de la dernière ligne rendue encore prise
+        };
+    }  // namespace server
+}  // namespace zappy
@@ -0,0 +1,135 @@
+//
+// EPITECH PROJECT, 2025
+// MessageFormat
+// File description:
+// Allocation-free message formatting helpers
+//
+
+#pragma once
+
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace zappy {
+    namespace server {
+
+        /**
+         * @brief Nombre de fois où un tampon de message a dû grandir.
+         *
+         * En régime établi les tampons gardent leur capacité, ce compteur
+         * doit donc rester stable pendant la partie.
+         */
+        inline std::atomic<size_t> messageAllocations{0};
+
+        /**
+         * @brief Ajoute une chaîne au message.
+         * @param out Message en construction.
+         * @param piece Morceau à ajouter.
+         */
+        inline void appendPiece(std::string &out, std::string_view piece)
+        {
+            out.append(piece.data(), piece.size());
+        }
+
+        /**
+         * @brief Ajoute une chaîne C au message.
+         * @param out Message en construction.
+         * @param piece Morceau à ajouter.
+         */
+        inline void appendPiece(std::string &out, const char *piece)
+        {
+            appendPiece(out, std::string_view(piece));
+        }
+
+        /**
+         * @brief Ajoute une std::string au message.
+         * @param out Message en construction.
+         * @param piece Morceau à ajouter.
+         */
+        inline void appendPiece(std::string &out, const std::string &piece)
+        {
+            out.append(piece);
+        }
+
+        /**
+         * @brief Ajoute un caractère au message.
+         * @param out Message en construction.
+         * @param piece Caractère à ajouter.
+         */
+        inline void appendPiece(std::string &out, char piece)
+        {
+            out.push_back(piece);
+        }
+
+        /**
+         * @brief Ajoute un entier au message avec std::to_chars.
+         * @param out Message en construction.
+         * @param value Entier à écrire en décimal.
+         */
+        template <typename T,
+            std::enable_if_t<std::is_integral_v<T> &&
+                                 !std::is_same_v<T, char> &&
+                                 !std::is_same_v<T, bool>,
+                int> = 0>
+        inline void appendPiece(std::string &out, T value)
+        {
+            char digits[24];
+            auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            out.append(digits, result.ptr - digits);
+        }
+
+        /**
+         * @brief Ajoute tous les morceaux au message, sans chaîne
+         * intermédiaire.
+         * @param out Message en construction.
+         * @param pieces Chaînes, caractères ou entiers à ajouter.
+         */
+        template <typename... Args>
+        void formatTo(std::string &out, const Args &...pieces)
+        {
+            size_t capacity = out.capacity();
+
+            (appendPiece(out, pieces), ...);
+            if (out.capacity() != capacity)
+                messageAllocations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Tampon de formatage réutilisable propre au thread.
+         *
+         * Le tampon est vidé mais garde sa capacité entre deux appels.
+         * Il ne doit pas être repris avant que le message précédent n'ait
+         * été copié dans un tampon de sortie.
+         * @return std::string& Tampon vide.
+         */
+        inline std::string &formatScratch()
+        {
+            thread_local std::string scratch;
+
+            scratch.clear();
+            return scratch;
+        }
+
+        /**
+         * @brief Lit un entier positif ou négatif au début d'un texte.
+         * @param text Texte à analyser, avancé après l'entier lu.
+         * @param value Entier lu.
+         * @return true si un entier a été lu.
+         */
+        inline bool parseInt(std::string_view &text, int &value)
+        {
+            while (!text.empty() && (text.front() == ' ' || text.front() == '#'))
+                text.remove_prefix(1);
+            auto result =
+                std::from_chars(text.data(), text.data() + text.size(), value);
+            if (result.ec != std::errc())
+                return false;
+            text.remove_prefix(result.ptr - text.data());
+            return true;
+        }
+    }  // namespace server
+}  // namespace zappy
@@ -0,0 +1,78 @@
+//
+// EPITECH PROJECT, 2025
+// TickOutput
+// File description:
+// Client output held until the end of the game tick
+//
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ClientOutput.hpp"
+
+namespace zappy {
+    namespace server {
+
+        /**
+         * @class TickOutput
+         * @brief Retient les tampons de sortie jusqu'à la fin de l'unité
+         * de temps du jeu.
+         *
+         * Tout ce qu'un client reçoit pendant une unité de temps part en
+         * un seul envoi, donc en un seul segment TCP, quand la boucle de
+         * jeu appelle flush(). Les tampons sont alors envoyés directement,
+         * ou confiés au backend réseau s'il envoie lui-même.
+         */
+        class TickOutput : public IOutputSink {
+           public:
+            /**
+             * @brief Définit le backend qui reçoit les tampons à chaque flush().
+             * @param next Backend réseau, nul pour envoyer directement.
+             */
+            void setNext(IOutputSink *next) { this->_next = next; }
+
+            void schedule(int socket, std::shared_ptr<ClientOutput> output) override
+            {
+                std::lock_guard<std::mutex> lock(this->_mutex);
+
+                this->_scheduled.emplace_back(socket, std::move(output));
+            }
+
+            /**
+             * @brief Envoie tous les tampons retenus depuis le dernier appel.
+             *
+             * Appelé par la boucle de jeu à chaque nouvelle unité de temps.
+             */
+            void flush()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(this->_mutex);
+                    this->_flushing.swap(this->_scheduled);
+                }
+                for (auto &[socket, output] : this->_flushing) {
+                    std::lock_guard<std::mutex> lock(output->mutex);
+
+                    if (this->_next) {
+                        this->_next->schedule(socket, output);
+                        continue;
+                    }
+                    output->scheduled = false;
+                    sendOutput(socket, output->buffer);
+                }
+                this->_flushing.clear();
+            }
+
+           private:
+            IOutputSink *_next = nullptr;  ///< Backend réseau, nul si direct
+            std::mutex _mutex;             ///< Protège _scheduled
+            std::vector<std::pair<int, std::shared_ptr<ClientOutput>>>
+                _scheduled;  ///< Tampons retenus pendant l'unité de temps
+            std::vector<std::pair<int, std::shared_ptr<ClientOutput>>>
+                _flushing;   ///< Tampons en cours d'envoi
+        };
+    }  // namespace server
+}  // namespace zappy
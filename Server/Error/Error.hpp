@@ -91,5 +91,18 @@ namespace zappy {
              */
             EggError(std::string msg) : Error(std::move(msg)) {}
         };
+
+        /**
+         * @class SnapshotError
+         * @brief Erreur liée à la sauvegarde ou au chargement d'un snapshot.
+         */
+        class SnapshotError : public Error {
+           public:
+            /**
+             * @brief Constructeur avec message d'erreur.
+             * @param msg Message d'erreur.
+             */
+            SnapshotError(std::string msg) : Error(std::move(msg)) {}
+        };
     }  // namespace error
 }  // namespace zappy
@@ -0,0 +1,53 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** CommandScheduler
+*/
+
+#include "CommandScheduler.hpp"
+
+#include <algorithm>
+
+const std::vector<std::shared_ptr<zappy::game::ServerPlayer>> &
+zappy::game::CommandScheduler::plan(
+    const std::vector<std::shared_ptr<ITeams>> &teamList, uint32_t tick)
+{
+    auto first = this->_first.lock();
+
+    this->_plan.clear();
+    if (tick != this->_tick) {
+        this->_tick = tick;
+        this->_spent = Clock::duration::zero();
+    }
+    if (this->_budget != Clock::duration::zero() && this->_spent >= this->_budget)
+        return this->_plan;
+    for (const auto &team : teamList) {
+        auto lock = team->lockPlayerList();
+
+        for (const auto &player : team->getPlayerListRef()) {
+            if (player)
+                this->_plan.push_back(player);
+        }
+    }
+    if (this->_plan.empty())
+        return this->_plan;
+    auto start = std::find(this->_plan.begin(), this->_plan.end(), first);
+
+    if (start != this->_plan.end())
+        std::rotate(this->_plan.begin(), start, this->_plan.end());
+    this->_first = this->_plan[1 % this->_plan.size()];
+    return this->_plan;
+}
+
+bool zappy::game::CommandScheduler::charge(size_t position, Clock::duration elapsed)
+{
+    this->_spent += elapsed;
+    if (this->_budget == Clock::duration::zero() || this->_spent < this->_budget)
+        return true;
+    if (position + 1 < this->_plan.size()) {
+        this->_first = this->_plan[position + 1];
+        this->_deferredLoops += 1;
+    }
+    return false;
+}
@@ -0,0 +1,84 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** CommandScheduler
+*/
+
+#pragma once
+
+#include "ITeams.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace zappy {
+    namespace game {
+        /**
+         * @brief Order in which the game loop runs the commands of the clients
+         *
+         * Each loop visits every client once, starting from a different one:
+         * the start moves by one client per loop, so no client is always
+         * served first. A budget can cap the time the commands of one time
+         * unit take on the game thread. Once it is spent, the clients not
+         * visited yet keep their lines and are served first, in the same
+         * order, when the next time unit starts.
+         *
+         * Game thread only.
+         */
+        class CommandScheduler {
+           public:
+            /** @brief Clock of the budget */
+            using Clock = std::chrono::steady_clock;
+
+            /**
+             * @brief Set the time the commands of one time unit may take
+             *
+             * @param budget Time allowed, zero for no limit
+             */
+            void setBudget(Clock::duration budget) { this->_budget = budget; }
+
+            /**
+             * @brief Get the clients to visit in this loop, in order
+             *
+             * Empty when the budget of the time unit is already spent.
+             *
+             * @param teamList Teams of the game, GUI team included
+             * @param tick Current time unit, a new one refills the budget
+             * @return const std::vector<std::shared_ptr<ServerPlayer>>& The
+             * clients, valid until the next call
+             */
+            const std::vector<std::shared_ptr<ServerPlayer>> &plan(
+                const std::vector<std::shared_ptr<ITeams>> &teamList, uint32_t tick);
+
+            /**
+             * @brief Count the time of a command against the budget
+             *
+             * @param position Index in the plan of the client that ran it
+             * @param elapsed Time spent running it on the game thread
+             * @return bool False when the budget is spent and the loop must
+             * stop, the clients after position being deferred
+             */
+            bool charge(size_t position, Clock::duration elapsed);
+
+            /**
+             * @brief Get the number of loops stopped by the budget
+             *
+             * @return uint64_t Loops that deferred clients to the next time unit
+             */
+            uint64_t getDeferredLoops() const { return this->_deferredLoops; }
+
+           private:
+            Clock::duration _budget = Clock::duration::zero();  ///< Set by setBudget()
+            Clock::duration _spent = Clock::duration::zero();   ///< Used in _tick
+            uint32_t _tick = 0;            ///< Time unit _spent belongs to
+            uint64_t _deferredLoops = 0;   ///< Returned by getDeferredLoops()
+
+            std::vector<std::shared_ptr<ServerPlayer>> _plan;  ///< Returned by plan()
+            std::weak_ptr<ServerPlayer> _first;  ///< Client served first by the next plan
+        };
+    }  // namespace game
+}  // namespace zappy
@@ -7,6 +7,8 @@
 
 #include "ClientCommand.hpp"
 
+#include <array>
+
 std::pair<int, int> zappy::game::CommandHandler::_computeBroadcastDistance(
     int x1, int y1, int x2, int y2)
 {
@@ -31,84 +33,99 @@ std::pair<int, int> zappy::game::CommandHandler::_computeBroadcastDistance(
     return {dx, dy};
 }
 
-int zappy::game::CommandHandler::_getSoundCardinalPoint(
-    int relativeX, int relativeY)
-{
-    if (relativeY < 0) {
-        if (relativeX < 0)
-            return static_cast<int>(SoundDirection::NORTHWEST);
-        else if (relativeX > 0)
-            return static_cast<int>(SoundDirection::NORTHEAST);
-        else
-            return static_cast<int>(SoundDirection::NORTH);
-    } else if (relativeY > 0) {
-        if (relativeX < 0)
-            return static_cast<int>(SoundDirection::SOUTHWEST);
-        else if (relativeX > 0)
-            return static_cast<int>(SoundDirection::SOUTHEAST);
-        else
-            return static_cast<int>(SoundDirection::SOUTH);
-    } else {
-        if (relativeX < 0)
-            return static_cast<int>(SoundDirection::WEST);
+namespace {
+    using SoundDirection = zappy::game::CommandHandler::SoundDirection;
+
+    /**
+     * @brief Sound direction seen by a receiver facing north
+     *
+     * Indexed by [sign(dx) + 1][sign(dy) + 1], dx and dy being the
+     * shortest torus offset from the receiver to the emitter.
+     */
+    constexpr int northDirections[3][3] = {
+        {static_cast<int>(SoundDirection::NORTHWEST),
+            static_cast<int>(SoundDirection::WEST),
+            static_cast<int>(SoundDirection::SOUTHWEST)},
+        {static_cast<int>(SoundDirection::NORTH),
+            static_cast<int>(SoundDirection::SAME_POSITION),
+            static_cast<int>(SoundDirection::SOUTH)},
+        {static_cast<int>(SoundDirection::NORTHEAST),
+            static_cast<int>(SoundDirection::EAST),
+            static_cast<int>(SoundDirection::SOUTHEAST)}};
+
+    using SoundTable = std::array<std::array<std::array<int, 3>, 3>, 4>;
+
+    /**
+     * @brief Rotate the emitter offset in the receiver frame for each
+     * orientation, then map it through northDirections
+     */
+    constexpr SoundTable buildSoundTable()
+    {
+        SoundTable table{};
+
+        for (int orientation = 0; orientation < 4; orientation += 1) {
+            for (int sx = -1; sx <= 1; sx += 1) {
+                for (int sy = -1; sy <= 1; sy += 1) {
+                    int relativeX = sx;
+                    int relativeY = sy;
+                    if (orientation == 1) {
+                        relativeX = -sy;
+                        relativeY = sx;
+                    } else if (orientation == 2) {
+                        relativeX = -sx;
+                        relativeY = -sy;
+                    } else if (orientation == 3) {
+                        relativeX = sy;
+                        relativeY = -sx;
+                    }
+                    table[orientation][sx + 1][sy + 1] =
+                        northDirections[relativeX + 1][relativeY + 1];
+                }
+            }
+        }
+        return table;
     }
-    return static_cast<int>(SoundDirection::EAST);
-}
 
-int zappy::game::CommandHandler::_computeSoundDirection(
-    const ServerPlayer &player, const ServerPlayer &receiver)
-{
-    if (player.x == receiver.x && player.y == receiver.y)
-        return static_cast<int>(SoundDirection::SAME_POSITION);
-
-    auto [dx, dy] = this->_computeBroadcastDistance(
-        static_cast<int>(receiver.x), static_cast<int>(receiver.y),
-        static_cast<int>(player.x), static_cast<int>(player.y));
-
-    int relativeX = 0;
-    int relativeY = 0;
-
-    switch (receiver.orientation) {
-        case Orientation::NORTH:
-            relativeX = dx;
-            relativeY = dy;
-            break;
-        case Orientation::EAST:
-            relativeX = -dy;
-            relativeY = dx;
-            break;
-        case Orientation::SOUTH:
-            relativeX = -dx;
-            relativeY = -dy;
-            break;
-        case Orientation::WEST:
-            relativeX = dy;
-            relativeY = -dx;
-            break;
+    /** @brief Sound direction by [orientation][sign(dx) + 1][sign(dy) + 1] */
+    constexpr SoundTable soundDirections = buildSoundTable();
+
+    constexpr int sign(int value)
+    {
+        return (value > 0) - (value < 0);
     }
-    return this->_getSoundCardinalPoint(relativeX, relativeY);
-}
+}  // namespace
 
 void zappy::game::CommandHandler::handleBroadcast(
     zappy::game::ServerPlayer &player, const std::string &arg)
 {
+    constexpr size_t directionPos = sizeof("message ") - 1;
+
     if (this->_waitCommand(player, timeLimit::BROADCAST) == false)
         return;
 
-    for (auto &team : this->_teamList) {
-        for (auto &teamPlayer : team->getPlayerList()) {
-            if (teamPlayer->getClient().getSocket() !=
-                player.getClient().getSocket()) {
-                int direction =
-                    this->_computeSoundDirection(player, *teamPlayer);
-                std::string broadcastMsg =
-                    "message " + std::to_string(direction) + ", " + arg + "\n";
-                teamPlayer->getClient().sendMessage(broadcastMsg);
-            }
-        }
-    }
-    player.setInAction(false);
+    std::string &broadcastMsg = zappy::server::formatScratch();
+    zappy::server::formatTo(broadcastMsg, "message 0, ", arg, '\n');
+
+    int emitterX = static_cast<int>(player.x);
+    int emitterY = static_cast<int>(player.y);
+    this->_players.forEachPlayer([this, &player, &broadcastMsg, emitterX,
+                                     emitterY](ServerPlayer &receiver,
+                                     uint32_t x, uint32_t y,
+                                     Orientation orientation) {
+        if (&receiver == &player)
+            return;
+        auto [dx, dy] = this->_computeBroadcastDistance(
+            static_cast<int>(x), static_cast<int>(y), emitterX, emitterY);
+        broadcastMsg[directionPos] = static_cast<char>('0' +
+            soundDirections[static_cast<size_t>(orientation)][sign(dx) + 1]
+                           [sign(dy) + 1]);
+        receiver.getClient().bufferMessage(broadcastMsg);
+    });
+    this->_players.forEachPlayer(
+        [&player](ServerPlayer &receiver, uint32_t, uint32_t, Orientation) {
+            if (&receiver != &player)
+                receiver.getClient().flushMessages();
+        });
     player.getClient().sendMessage("ok\n");
-    this->messageToGUI(std::string(
-        "pbc #" + std::to_string(player.getId()) + " " + arg + "\n"));
+    this->messageToGUI("pbc #", player.getId(), ' ', arg, '\n');
 }
@@ -7,135 +7,124 @@
 
 #include "ClientCommand.hpp"
 #include "Game.hpp"
+#include <iterator>
 
-void zappy::game::CommandHandler::messageToGUI(const std::string &msg)
-{
-    for (auto &team : _teamList) {
-        if (team->getName() == "GRAPHIC") {
-            for (auto &player : team->getPlayerList()) {
-                if (player)
-                    player->getClient().sendMessage(msg);
-            }
-        }
-    }
-}
-
-void zappy::game::CommandHandler::initCommandMap()
-{
-    this->_commandMap = {
-        {"Forward",
-            [this](ServerPlayer &player, const std::string &) {
-                handleForward(player);
-            }},
-        {"Right",
-            [this](ServerPlayer &player, const std::string &) {
-                handleRight(player);
-            }},
-        {"Left",
-            [this](ServerPlayer &player, const std::string &) {
-                handleLeft(player);
-            }},
-        {"Look",
-            [this](ServerPlayer &player, const std::string &) {
-                handleLook(player);
-            }},
-        {"Inventory",
-            [this](ServerPlayer &player, const std::string &) {
-                handleInventory(player);
-            }},
-        {"Broadcast",
-            [this](ServerPlayer &player, const std::string &arg) {
-                handleBroadcast(player, arg);
-            }},
-        {"Connect_nbr",
-            [this](ServerPlayer &player, const std::string &) {
-                handleConnectNbr(player);
-            }},
-        {"Fork",
-            [this](ServerPlayer &player, const std::string &) {
-                handleFork(player);
-            }},
-        {"Eject",
-            [this](ServerPlayer &player, const std::string &) {
-                handleEject(player);
-            }},
-        {"Take",
-            [this](ServerPlayer &player, const std::string &arg) {
-                handleTake(player, arg);
-            }},
-        {"Set",
-            [this](ServerPlayer &player, const std::string &arg) {
-                handleDrop(player, arg);
-            }},
-        {"Incantation", [this](ServerPlayer &player, const std::string &) {
-             handleIncantation(player);
-         }}};
-}
+namespace {
+    /**
+     * @brief End of the protocol delay of the command of this thread
+     *
+     * Set by _waitCommand(), left unset when the command is interrupted.
+     */
+    thread_local std::chrono::steady_clock::time_point commandWorkStart;
+}  // namespace
 
 bool zappy::game::CommandHandler::_waitCommand(ServerPlayer &player, timeLimit limit)
 {
     auto commandTime = static_cast<double>(limit) / this->_freq;
     auto timeNeeded = std::chrono::duration<double>(commandTime);
     
-    auto startTime = std::chrono::steady_clock::now();
-    auto endTime = startTime + timeNeeded;
-    
+    auto startTime = this->_clock.now();
+    auto endTime = startTime +
+        std::chrono::duration_cast<GameClock::Clock::duration>(timeNeeded);
+
+    if (this->_clock.isVirtual()) {
+        if (!this->_clock.waitUntil(endTime, [&player]() { return player.interrupted.load(); })) {
+            player.stopPraying();
+            return false;
+        }
+        commandWorkStart = std::chrono::steady_clock::now();
+        return true;
+    }
     while (std::chrono::steady_clock::now() < endTime) {
         auto tickDuration = std::chrono::duration<double>(1.0 / this->_freq);
         std::this_thread::sleep_for(tickDuration);
 
         if (player.interrupted) {
             player.stopPraying();
-            player.setInAction(false);
             return false;
         }
     }
+    commandWorkStart = std::chrono::steady_clock::now();
     return true;
 }
 
 void zappy::game::CommandHandler::_executeCommand(
-    zappy::game::ServerPlayer &player,
-    std::function<void(ServerPlayer &, const std::string &)> function,
-    const std::string &args)
+    zappy::game::ServerPlayer &player, ClientOpcode opcode, Handler handler,
+    std::string args)
 {
-    std::thread commandThread([&player, function, args]() {
-        if (player.isInAction()) {
-            return;
-        }
-        std::lock_guard<std::mutex> lock(*(player.getClient().queueMutex));
-        if (player.getClient().queueMessage.empty())
-            return;
-        player.getClient().queueMessage.pop();
+    player.interrupted = false;
+    this->_clock.beginWork();
+    std::thread commandThread([this, self = player.shared_from_this(), opcode,
+                                  handler, args = std::move(args)]() {
+        self->startChrono();
 
-        player.setInAction(true);
-        player.startChrono();
-
-        function(player, args);
-        player.setInAction(false);
+        handler(*this, *self, args);
+        if (commandWorkStart != std::chrono::steady_clock::time_point())
+            this->_profiler.recordCommand(TickProfiler::command(opcode),
+                std::chrono::steady_clock::now() - commandWorkStart);
+        self->setInAction(false);
+        this->_clock.endWork();
     });
     commandThread.detach();
 }
 
+/**
+ * @brief Run an AI command
+ *
+ * The line is split in place and the command found through a switch on
+ * its length and first letter. Only the arguments are copied, for the
+ * command thread to own them.
+ */
 void zappy::game::CommandHandler::processClientInput(
-    std::string &input, zappy::game::ServerPlayer &player)
+    std::string_view input, zappy::game::ServerPlayer &player)
 {
-    if (this->_commandMap.empty())
-        this->initCommandMap();
+    static constexpr Handler handlers[] = {
+        [](CommandHandler &self, ServerPlayer &player, const std::string &) {
+            self.handleForward(player);
+        },
+        [](CommandHandler &self, ServerPlayer &player, const std::string &) {
+            self.handleRight(player);
+        },
+        [](CommandHandler &self, ServerPlayer &player, const std::string &) {
+            self.handleLeft(player);
+        },
+        [](CommandHandler &self, ServerPlayer &player, const std::string &) {
+            self.handleLook(player);
+        },
+        [](CommandHandler &self, ServerPlayer &player, const std::string &) {
+            self.handleInventory(player);
+        },
+        [](CommandHandler &self, ServerPlayer &player, const std::string &arg) {
+            self.handleBroadcast(player, arg);
+        },
+        [](CommandHandler &self, ServerPlayer &player, const std::string &) {
+            self.handleConnectNbr(player);
+        },
+        [](CommandHandler &self, ServerPlayer &player, const std::string &) {
+            self.handleFork(player);
+        },
+        [](CommandHandler &self, ServerPlayer &player, const std::string &) {
+            self.handleEject(player);
+        },
+        [](CommandHandler &self, ServerPlayer &player, const std::string &arg) {
+            self.handleTake(player, arg);
+        },
+        [](CommandHandler &self, ServerPlayer &player, const std::string &arg) {
+            self.handleDrop(player, arg);
+        },
+        [](CommandHandler &self, ServerPlayer &player, const std::string &) {
+            self.handleIncantation(player);
+        }};
+    static_assert(std::size(handlers) == static_cast<size_t>(ClientOpcode::UNKNOWN),
+        "one AI handler per opcode");
 
-    auto spacePos = input.find(' ');
-    std::string cmd = input.substr(0, spacePos);
-    std::string args =
-        (spacePos != std::string::npos) ? input.substr(spacePos + 1) : "";
+    auto line = splitCommand(input);
+    auto opcode = clientOpcode(line.name);
 
-    if (!args.empty() && args.back() == '\n')
-        args.pop_back();
-
-    auto it = this->_commandMap.find(cmd);
-    if (it != this->_commandMap.end())
-        return this->_executeCommand(player, it->second, args);
-    if (player.isInAction() == false) {
-        std::lock_guard<std::mutex> lock(player.msgMutex);
-        player.getClient().queueMessage.pop();
-        player.getClient().sendMessage("ko\n");
+    if (opcode == ClientOpcode::UNKNOWN) {
+        player.setInAction(false);
+        return player.getClient().sendMessage("ko\n");
     }
+    this->_executeCommand(player, opcode,
+        handlers[static_cast<size_t>(opcode)], std::string(line.args));
 }
@@ -7,18 +7,20 @@
 
 #pragma once
 
+#include "GameClock.hpp"
 #include "GameError.hpp"
 #include "GuiCommand.hpp"
+#include "IncantationSession.hpp"
 #include "ITeams.hpp"
 #include "Orientation.hpp"
 #include "Player.hpp"
+#include "PlayerTable.hpp"
 #include "Resource.hpp"
 #include "ServerMap.hpp"
 #include "ServerPlayer.hpp"
 
 #include <algorithm>
 #include <chrono>
-#include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -120,12 +122,19 @@ namespace zappy {
              * @param clientNb Number of clients
              * @param map Reference to the game map server
              * @param teamList Reference to the list of teams
+             * @param serializer Threads rendering large mct answers
+             * @param profiler Receives the execution time of each command
+             * @param players Reference to the player table of the game
+             * @param clock Time the command delays are measured in
              */
             CommandHandler(int &freq, int width, int height, int clientNb,
                 zappy::game::MapServer &map,
-                std::vector<std::shared_ptr<ITeams>> &teamList)
-                : CommandHandlerGui(
-                      freq, width, height, clientNb, map, teamList) {};
+                std::vector<std::shared_ptr<ITeams>> &teamList,
+                SerializePool &serializer, TickProfiler &profiler,
+                PlayerTable &players, GameClock &clock)
+                : CommandHandlerGui(freq, width, height, clientNb, map,
+                      teamList, serializer, profiler),
+                  _players(players), _clock(clock) {};
 
             /**
              * @brief Destructor for CommandHandler
@@ -138,15 +147,18 @@ namespace zappy {
              * @param input The input string from the client
              * @param player Reference to the server player object
              */
-            void processClientInput(std::string &input,
+            void processClientInput(std::string_view input,
                 zappy::game::ServerPlayer &player) override;
 
             /**
-             * @brief Handle incantation printing for GUI
+             * @brief Remove a player from the incantation it takes part in
              * 
-             * @param player Reference to the player performing incantation
+             * A participant other than the leader is released and told that
+             * the incantation failed for it.
+             * 
+             * @param player Reference to the player ejected or dead
              */
-            void incantationPrinting(zappy::game::ServerPlayer &player);
+            void interruptIncantation(zappy::game::ServerPlayer &player);
 
             /**
              * @brief Send resource information to GUI
@@ -155,11 +167,6 @@ namespace zappy {
              */
             void resourceSendGui(zappy::game::ServerPlayer &player);
 
-            /**
-             * @brief Initialize the command map with available commands
-             */
-            void initCommandMap() override;
-
             /**
              * @brief Get the current game frequency
              * 
@@ -170,23 +177,64 @@ namespace zappy {
             /**
              * @brief Send a message to the GUI
              * 
-             * @param msg The message to send to the GUI
+             * The message is formatted once in a thread-local buffer, then
+             * copied into the output buffer of every GUI client.
+             * 
+             * @param pieces Strings, characters or integers forming the message
              */
-            void messageToGUI(const std::string &msg);
+            template <typename... Args>
+            void messageToGUI(const Args &...pieces)
+            {
+                std::string &msg = zappy::server::formatScratch();
+
+                zappy::server::formatTo(msg, pieces...);
+                for (auto &team : this->_teamList) {
+                    if (team->getName() != "GRAPHIC")
+                        continue;
+                    team->forEachPlayer([&msg](ServerPlayer &gui) {
+                        gui.getClient().sendMessage(msg);
+                    });
+                }
+            }
+
+            /**
+             * @brief Entry of the AI dispatch table, indexed by ClientOpcode
+             */
+            using Handler = void (*)(CommandHandler &, ServerPlayer &, const std::string &);
 
             /**
              * @brief Execute a command with proper timing and validation
              * 
+             * The time spent by the handler after its protocol delay is
+             * recorded in the profiler. The thread holds a shared_ptr to the
+             * player, which may die or disconnect before the command ends.
+             * The game loop reserves the player before calling it, and the
+             * thread releases the player once the handler has returned.
+             * 
              * @param player Reference to the player executing the command
-             * @param function Function pointer to the command to execute
-             * @param args Arguments for the command
+             * @param opcode Command being executed
+             * @param handler Entry of the dispatch table to run
+             * @param args Arguments for the command, owned by its thread
              */
             void _executeCommand(zappy::game::ServerPlayer &player,
-                std::function<void(ServerPlayer &, const std::string &)>
-                    function,
-                const std::string &args);
+                ClientOpcode opcode, Handler handler, std::string args);
 
            private:
+            /**
+             * @brief Incantations in progress and their participants
+             */
+            IncantationRegistry _incantations;
+
+            /**
+             * @brief Hot fields of every AI player, synced after each move
+             */
+            PlayerTable &_players;
+
+            /**
+             * @brief Time of the game, virtual during a replay
+             */
+            GameClock &_clock;
+
             /**
              * @brief Handle forward movement command
              * 
@@ -217,52 +265,36 @@ namespace zappy {
 
             /**
              * @brief Build the look message containing visible tiles
+             *
+             * Walks the precomputed vision cone of the player orientation
+             * (see LookTable.hpp) instead of recomputing each target tile.
+             * Only the shards covering the cone are locked, so a look
+             * costs the same on any map size.
              * 
              * @param player Reference to the player performing the look
-             * @return String containing the look message
+             * @return Look message, stored in the thread-local format buffer
              */
-            std::string _buildLookMessage(ServerPlayer &player);
+            const std::string &_buildLookMessage(ServerPlayer &player);
 
             /**
-             * @brief Get the content of a specific line in the look view
-             * 
-             * @param player Reference to the player looking
-             * @param line The line number in the look view
-             * @return String containing the line content
-             */
-            std::string _lookLine(ServerPlayer &player, size_t line);
-
-            /**
-             * @brief Compute the target coordinates for a look operation
-             * 
-             * @param player Reference to the player looking
-             * @param line The line number in the look view
-             * @param offset The offset within the line
-             * @return Pair of coordinates (x, y)
-             */
-            std::pair<int, int> _computeLookTarget(
-                ServerPlayer &player, size_t line, int offset);
-
-            /**
-             * @brief Get the content of a tile at specific coordinates
+             * @brief Append the content of a tile to a look message
              * 
+             * @param msg Look message being built
              * @param x X coordinate of the tile
              * @param y Y coordinate of the tile
              * @param isPlayerTile Whether this is the player's current tile
-             * @return String describing the tile content
              */
-            std::string _getTileContent(size_t x, size_t y, bool isPlayerTile);
+            void _appendTileContent(
+                std::string &msg, size_t x, size_t y, bool isPlayerTile);
 
             /**
-             * @brief Check if a tile is the last tile in the look view
+             * @brief Count the players standing on a tile
              * 
-             * @param playerLevel Level of the player
-             * @param line Line number in the look view
-             * @param offset Offset within the line
-             * @return True if it's the last tile, false otherwise
+             * @param x X coordinate of the tile
+             * @param y Y coordinate of the tile
+             * @return Number of players on the tile
              */
-            bool _checkLastTileInLook(
-                size_t playerLevel, size_t line, int offset);
+            size_t _countPlayersOnTile(int x, int y);
 
             /**
              * @brief Handle inventory command to show player's resources
@@ -292,25 +324,6 @@ namespace zappy {
             std::pair<int, int> _computeBroadcastDistance(
                 int x1, int y1, int x2, int y2);
 
-            /**
-             * @brief Compute the sound direction for a broadcast message
-             * 
-             * @param player Reference to the broadcasting player
-             * @param receiver Reference to the receiving player
-             * @return Integer representing the sound direction
-             */
-            int _computeSoundDirection(
-                const ServerPlayer &player, const ServerPlayer &receiver);
-
-            /**
-             * @brief Get the cardinal point for sound direction
-             * 
-             * @param relativeX Relative X coordinate
-             * @param relativeY Relative Y coordinate
-             * @return Integer representing the cardinal point
-             */
-            int _getSoundCardinalPoint(int relativeX, int relativeY);
-
             /**
              * @brief Handle connect_nbr command to get available connections
              * 
@@ -357,14 +370,6 @@ namespace zappy {
              */
             void handleIncantation(zappy::game::ServerPlayer &player);
 
-            /**
-             * @brief Check if incantation conditions are met
-             * 
-             * @param player Reference to the player attempting incantation
-             * @return True if conditions are met, false otherwise
-             */
-            bool _checkIncantationConditions(const ServerPlayer &player);
-
             /**
              * @brief Get players eligible for incantation at a location
              * 
@@ -376,17 +381,6 @@ namespace zappy {
             std::vector<std::weak_ptr<ServerPlayer>> _getPlayersForIncant(
                 int x, int y, size_t level);
 
-            /**
-             * @brief Get players currently incanting at a location
-             * 
-             * @param x X coordinate of the location
-             * @param y Y coordinate of the location
-             * @param level Required level for incantation
-             * @return Vector of weak pointers to incanting players
-             */
-            std::vector<std::weak_ptr<ServerPlayer>> _getPlayersIncanting(
-                int x, int y, size_t level);
-
             /**
              * @brief Check if required resources are available for incantation
              * 
@@ -400,25 +394,15 @@ namespace zappy {
             /**
              * @brief Consume resources required for elevation
              * 
+             * The resources are checked and removed under the same tile lock,
+             * so two incantations cannot both spend them.
+             * 
              * @param x X coordinate of the location
              * @param y Y coordinate of the location
              * @param level Level for which to consume resources
+             * @return True if the resources were there and are consumed
              */
-            void _consumeElevationResources(size_t x, size_t y, size_t level);
-
-            /**
-             * @brief Elevate a player to the next level
-             * 
-             * @param player Reference to the player to elevate
-             */
-            void _elevatePlayer(ServerPlayer &player);
-
-            /**
-             * @brief Set a player in prayer state for incantation
-             * 
-             * @param player Reference to the player to set in prayer
-             */
-            void _setPrayer(zappy::game::ServerPlayer &player);
+            bool _consumeElevationResources(size_t x, size_t y, size_t level);
 
             /**
              * @brief Get all players on a specific tile
@@ -459,15 +443,6 @@ namespace zappy {
             [[nodiscard]] bool _waitCommand(
                 ServerPlayer &player, timeLimit limit);
 
-            /**
-             * @brief Normalize coordinates to fit within map boundaries
-             * 
-             * @param x X coordinate to normalize
-             * @param y Y coordinate to normalize
-             * @return Pair of normalized coordinates
-             */
-            std::pair<size_t, size_t> _normalizeCoords(size_t x, size_t y);
-
             /**
              * @brief Get direction vector based on player orientation
              * 
@@ -476,6 +451,13 @@ namespace zappy {
              * @param dy Reference to Y direction component
              */
             void _getDirectionVector(const Player &player, int &dx, int &dy);
+
+            /**
+             * @brief Send a player position update (ppo) to the GUI
+             * 
+             * @param player Reference to the player whose position changed
+             */
+            void _positionToGUI(const ServerPlayer &player);
         };
     }  // namespace game
 
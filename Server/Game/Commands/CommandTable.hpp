@@ -0,0 +1,217 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** CommandTable
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace zappy {
+    namespace game {
+        /**
+         * @brief Commands of the AI protocol
+         *
+         * Used as an index in the dispatch table of CommandHandler, keep
+         * UNKNOWN last.
+         */
+        enum class ClientOpcode : uint8_t {
+            FORWARD,
+            RIGHT,
+            LEFT,
+            LOOK,
+            INVENTORY,
+            BROADCAST,
+            CONNECT_NBR,
+            FORK,
+            EJECT,
+            TAKE,
+            SET,
+            INCANTATION,
+            UNKNOWN
+        };
+
+        /**
+         * @brief Commands of the GUI protocol
+         *
+         * Used as an index in the dispatch table of CommandHandlerGui, keep
+         * UNKNOWN last.
+         */
+        enum class GuiOpcode : uint8_t {
+            MSZ,
+            BCT,
+            MCT,
+            TNA,
+            PPO,
+            PLV,
+            PIN,
+            SGT,
+            SST,
+            TST,
+            UNKNOWN
+        };
+
+        /**
+         * @brief A received line split into its command and its arguments
+         *
+         * Both views point into the received line.
+         */
+        struct CommandLine {
+            std::string_view name; /**< Text before the first space */
+            std::string_view args; /**< Text after the first space, may be empty */
+        };
+
+        /**
+         * @brief Split a received line without copying it
+         *
+         * @param input Line received from a client, with or without its '\n'
+         * @return CommandLine Views on the command and its arguments
+         */
+        constexpr CommandLine splitCommand(std::string_view input)
+        {
+            if (!input.empty() && input.back() == '\n')
+                input.remove_suffix(1);
+            size_t space = input.find(' ');
+            if (space == std::string_view::npos)
+                return {input, {}};
+            return {input.substr(0, space), input.substr(space + 1)};
+        }
+
+        /**
+         * @brief Get the opcode of an AI command
+         *
+         * Switches on the length and the first letter, which leaves at most
+         * one candidate, then compares the whole name once.
+         *
+         * @param name Command name, case sensitive
+         * @return ClientOpcode The command, UNKNOWN if none matches
+         */
+        constexpr ClientOpcode clientOpcode(std::string_view name)
+        {
+            struct Candidate {
+                std::string_view name;
+                ClientOpcode opcode;
+            };
+            Candidate candidate = {{}, ClientOpcode::UNKNOWN};
+
+            if (name.empty())
+                return ClientOpcode::UNKNOWN;
+            switch (name.size()) {
+                case 3: candidate = {"Set", ClientOpcode::SET}; break;
+                case 4:
+                    if (name[0] == 'F')
+                        candidate = {"Fork", ClientOpcode::FORK};
+                    else if (name[0] == 'T')
+                        candidate = {"Take", ClientOpcode::TAKE};
+                    else if (name[1] == 'e')
+                        candidate = {"Left", ClientOpcode::LEFT};
+                    else
+                        candidate = {"Look", ClientOpcode::LOOK};
+                    break;
+                case 5:
+                    if (name[0] == 'R')
+                        candidate = {"Right", ClientOpcode::RIGHT};
+                    else
+                        candidate = {"Eject", ClientOpcode::EJECT};
+                    break;
+                case 7: candidate = {"Forward", ClientOpcode::FORWARD}; break;
+                case 9:
+                    if (name[0] == 'I')
+                        candidate = {"Inventory", ClientOpcode::INVENTORY};
+                    else
+                        candidate = {"Broadcast", ClientOpcode::BROADCAST};
+                    break;
+                case 11:
+                    if (name[0] == 'C')
+                        candidate = {"Connect_nbr", ClientOpcode::CONNECT_NBR};
+                    else
+                        candidate = {"Incantation", ClientOpcode::INCANTATION};
+                    break;
+                default: break;
+            }
+            return name == candidate.name ? candidate.opcode : ClientOpcode::UNKNOWN;
+        }
+
+        /**
+         * @brief Pack a three letter GUI command into an integer
+         *
+         * Every GUI command has three letters, so the packing is a perfect
+         * hash: two commands never share a key.
+         *
+         * @param name Command name
+         * @return uint32_t The three bytes of the name, 0 for other lengths
+         */
+        constexpr uint32_t guiCommandKey(std::string_view name)
+        {
+            if (name.size() != 3)
+                return 0;
+            return static_cast<uint32_t>(static_cast<unsigned char>(name[0])) << 16 |
+                static_cast<uint32_t>(static_cast<unsigned char>(name[1])) << 8 |
+                static_cast<uint32_t>(static_cast<unsigned char>(name[2]));
+        }
+
+        /**
+         * @brief Get the opcode of a GUI command
+         *
+         * @param name Command name
+         * @return GuiOpcode The command, UNKNOWN if none matches
+         */
+        constexpr GuiOpcode guiOpcode(std::string_view name)
+        {
+            switch (guiCommandKey(name)) {
+                case guiCommandKey("msz"): return GuiOpcode::MSZ;
+                case guiCommandKey("bct"): return GuiOpcode::BCT;
+                case guiCommandKey("mct"): return GuiOpcode::MCT;
+                case guiCommandKey("tna"): return GuiOpcode::TNA;
+                case guiCommandKey("ppo"): return GuiOpcode::PPO;
+                case guiCommandKey("plv"): return GuiOpcode::PLV;
+                case guiCommandKey("pin"): return GuiOpcode::PIN;
+                case guiCommandKey("sgt"): return GuiOpcode::SGT;
+                case guiCommandKey("sst"): return GuiOpcode::SST;
+                case guiCommandKey("tst"): return GuiOpcode::TST;
+                default: return GuiOpcode::UNKNOWN;
+            }
+        }
+
+        /**
+         * @brief Name of each AI command, indexed by ClientOpcode
+         */
+        constexpr std::string_view clientCommandNames[] = {"Forward", "Right",
+            "Left", "Look", "Inventory", "Broadcast", "Connect_nbr", "Fork",
+            "Eject", "Take", "Set", "Incantation"};
+
+        /**
+         * @brief Name of each GUI command, indexed by GuiOpcode
+         */
+        constexpr std::string_view guiCommandNames[] = {"msz", "bct", "mct",
+            "tna", "ppo", "plv", "pin", "sgt", "sst", "tst"};
+
+        static_assert(std::size(clientCommandNames) ==
+                static_cast<size_t>(ClientOpcode::UNKNOWN),
+            "one name per AI opcode");
+        static_assert(std::size(guiCommandNames) ==
+                static_cast<size_t>(GuiOpcode::UNKNOWN),
+            "one name per GUI opcode");
+        static_assert(clientOpcode(clientCommandNames[static_cast<size_t>(
+                          ClientOpcode::INCANTATION)]) == ClientOpcode::INCANTATION &&
+                guiOpcode(guiCommandNames[static_cast<size_t>(GuiOpcode::TST)]) ==
+                    GuiOpcode::TST,
+            "command names must follow the opcode order");
+        static_assert(clientOpcode("Look") == ClientOpcode::LOOK &&
+                clientOpcode("Left") == ClientOpcode::LEFT &&
+                clientOpcode("Connect_nbr") == ClientOpcode::CONNECT_NBR &&
+                clientOpcode("Incantation") == ClientOpcode::INCANTATION &&
+                clientOpcode("Lookx") == ClientOpcode::UNKNOWN &&
+                clientOpcode("look") == ClientOpcode::UNKNOWN,
+            "clientOpcode must only accept exact command names");
+        static_assert(guiOpcode("tst") == GuiOpcode::TST &&
+                guiOpcode("tstx") == GuiOpcode::UNKNOWN &&
+                guiOpcode("") == GuiOpcode::UNKNOWN,
+            "guiOpcode must only accept exact command names");
+    }  // namespace game
+}  // namespace zappy
@@ -6,6 +6,8 @@
 //
 
 #include "ClientCommand.hpp"
+#include "LookTable.hpp"
+#include "ShardLock.hpp"
 #include "Orientation.hpp"
 #include "ServerPlayer.hpp"
 #include <algorithm>
@@ -16,22 +18,7 @@
 std::vector<std::weak_ptr<zappy::game::ServerPlayer>>
 zappy::game::CommandHandler::_getPlayerOnTile(int x, int y)
 {
-    std::vector<std::weak_ptr<ServerPlayer>> playerList;
-
-    auto retrievePlayerFromTeam = [&playerList, x, y](
-                                      std::weak_ptr<ITeams> team) {
-        auto teamUnlock = team.lock();
-        if (teamUnlock && teamUnlock->getName() != "GRAPHIC") {
-            for (auto player : teamUnlock->getPlayerList()) {
-                if (player && player->x == x && player->y == y)
-                    playerList.push_back(player);
-            }
-        }
-    };
-    std::for_each(this->_teamList.begin(), this->_teamList.end(),
-        retrievePlayerFromTeam);
-
-    return playerList;
+    return this->_players.playersOnTile(x, y);
 }
 
 void zappy::game::CommandHandler::_sendExpulseMsg(
@@ -54,8 +41,7 @@ void zappy::game::CommandHandler::_sendExpulseMsg(
         directionPushed = 5;
     if (pushingDx == -1 && pushingDy == 0)
         directionPushed = 7;
-    std::string expulseMsg = "eject: " + std::to_string(directionPushed);
-    player.getClient().sendMessage(expulseMsg);
+    player.getClient().sendFormatted("eject: ", directionPushed, '\n');
 }
 
 void zappy::game::CommandHandler::ejectPlayerForward(ServerPlayer &player,
@@ -83,6 +69,7 @@ void zappy::game::CommandHandler::ejectPlayerForward(ServerPlayer &player,
         player.x = (player.x + width) % width;
     if (player.y >= height || player.y <= 0)
         player.y = (player.y + height) % height;
+    this->_players.sync(player);
 
     this->_sendExpulseMsg(player, pushingPlayer);
 }
@@ -93,18 +80,28 @@ void zappy::game::CommandHandler::handleEject(
     if (this->_waitCommand(player, timeLimit::EJECT) == false)
         return;
     auto playerOrientation = player.orientation;
+    int dx = 0;
+    int dy = 0;
+    this->_getDirectionVector(player, dx, dy);
+    ShardLock lock(this->_map);
 
+    lock.addTile(player.x, player.y);
+    lock.addTile(wrapCoord(player.x + dx, this->_widthMap),
+        wrapCoord(player.y + dy, this->_heightMap));
+    lock.lock();
     auto playerList = this->_getPlayerOnTile(player.x, player.y);
+    bool ejected = false;
     for (auto &playerOnTile : playerList) {
         auto playerOnTileUnlock = playerOnTile.lock();
         if (playerOnTileUnlock &&
             player.getId() != playerOnTileUnlock->getId()) {
             playerOnTileUnlock->interrupted = true;
+            this->interruptIncantation(*playerOnTileUnlock);
             ejectPlayerForward(*playerOnTileUnlock, playerOrientation, player);
+            ejected = true;
 
-            std::string expulseMsgGui =
-                "pex " + std::to_string(playerOnTileUnlock->getId());
-            messageToGUI(expulseMsgGui);
+            messageToGUI("pex #", playerOnTileUnlock->getId(), '\n');
         }
     }
+    player.getClient().sendMessage(ejected ? "ok\n" : "ko\n");
 }
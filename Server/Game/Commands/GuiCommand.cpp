@@ -6,77 +6,62 @@
 */
 
 #include "GuiCommand.hpp"
+#include <iterator>
 
-void zappy::game::CommandHandlerGui::initCommandMap()
-{
-    this->_commandMapGui = {
-        {"msz",
-            [this](ServerPlayer &player, const std::string &) {
-                handleMsz(player);
-            }},
-        {"bct",
-            [this](ServerPlayer &player, const std::string &arg) {
-                handleBct(player, arg);
-            }},
-        {"mct",
-            [this](ServerPlayer &player, const std::string &) {
-                handleMct(player);
-            }},
-        {"tna",
-            [this](ServerPlayer &player, const std::string &) {
-                handleTna(player);
-            }},
-        {"ppo",
-            [this](ServerPlayer &player, const std::string &arg) {
-                handlePpo(player, arg);
-            }},
-        {"plv",
-            [this](ServerPlayer &player, const std::string &arg) {
-                handlePlv(player, arg);
-            }},
-        {"pin",
-            [this](ServerPlayer &player, const std::string &arg) {
-                handlePin(player, arg);
-            }},
-        {"sgt",
-            [this](ServerPlayer &player, const std::string &) {
-                handleSgt(player);
-            }},
-        {"sst", [this](ServerPlayer &player, const std::string &arg) {
-             handleSst(player, arg);
-         }}};
-}
-
+/**
+ * @brief Run a GUI command
+ *
+ * The line is split in place and the command found through a switch on
+ * its three letters, nothing is allocated before the handler runs. The
+ * handlers parse their "#n" arguments themselves. The time spent in the
+ * handler is recorded in the profiler.
+ */
 void zappy::game::CommandHandlerGui::processClientInput(
-    std::string &input, zappy::game::ServerPlayer &player)
+    std::string_view input, zappy::game::ServerPlayer &player)
 {
-    if (this->_commandMapGui.empty())
-        this->initCommandMap();
-
-    size_t pos = input.find('#');
-
-    while (pos != std::string::npos) {
-        input.erase(pos, 1);
-        pos = input.find('#');
-    }
+    using Handler = void (*)(CommandHandlerGui &, ServerPlayer &, std::string_view);
+    static constexpr Handler handlers[] = {
+        [](CommandHandlerGui &self, ServerPlayer &gui, std::string_view) {
+            self.handleMsz(gui);
+        },
+        [](CommandHandlerGui &self, ServerPlayer &gui, std::string_view arg) {
+            self.handleBct(gui, arg);
+        },
+        [](CommandHandlerGui &self, ServerPlayer &gui, std::string_view) {
+            self.handleMct(gui);
+        },
+        [](CommandHandlerGui &self, ServerPlayer &gui, std::string_view) {
+            self.handleTna(gui);
+        },
+        [](CommandHandlerGui &self, ServerPlayer &gui, std::string_view arg) {
+            self.handlePpo(gui, arg);
+        },
+        [](CommandHandlerGui &self, ServerPlayer &gui, std::string_view arg) {
+            self.handlePlv(gui, arg);
+        },
+        [](CommandHandlerGui &self, ServerPlayer &gui, std::string_view arg) {
+            self.handlePin(gui, arg);
+        },
+        [](CommandHandlerGui &self, ServerPlayer &gui, std::string_view) {
+            self.handleSgt(gui);
+        },
+        [](CommandHandlerGui &self, ServerPlayer &gui, std::string_view arg) {
+            self.handleSst(gui, arg);
+        },
+        [](CommandHandlerGui &self, ServerPlayer &gui, std::string_view arg) {
+            self.handleTst(gui, arg);
+        }};
+    static_assert(std::size(handlers) == static_cast<size_t>(GuiOpcode::UNKNOWN),
+        "one GUI handler per opcode");
 
-    auto spacePos = input.find(' ');
-    std::string cmd = input.substr(0, spacePos);
-    std::string args =
-        (spacePos != std::string::npos) ? input.substr(spacePos + 1) : "";
+    auto line = splitCommand(input);
+    auto opcode = guiOpcode(line.name);
 
-    if (!args.empty() && args.back() == '\n')
-        args.pop_back();
+    if (opcode == GuiOpcode::UNKNOWN)
+        return player.getClient().sendMessage("suc\n");
+    auto start = std::chrono::steady_clock::now();
 
-    auto it = this->_commandMapGui.find(cmd);
-    std::lock_guard<std::mutex> lock(*(player.getClient().queueMutex));
-    if (it != this->_commandMapGui.end()) {
-        it->second(player, args);
-        if (!player.getClient().queueMessage.empty())
-            player.getClient().queueMessage.pop();
-        return;
-    }
-    player.getClient().sendMessage("suc\n");
-    if (!player.getClient().queueMessage.empty())
-        player.getClient().queueMessage.pop();
+    handlers[static_cast<size_t>(opcode)](*this, player, line.args);
+    this->_profiler.recordCommand(TickProfiler::command(opcode),
+        std::chrono::steady_clock::now() - start);
 }
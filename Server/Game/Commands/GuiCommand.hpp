@@ -7,10 +7,14 @@
 
 #pragma once
 
+#include "CommandTable.hpp"
+#include "SerializePool.hpp"
 #include "ServerMap.hpp"
 #include "TeamsPlayer.hpp"
+#include "TickProfiler.hpp"
 
 #include <sstream>
+#include <string_view>
 
 namespace zappy {
     namespace game {
@@ -34,12 +38,16 @@ namespace zappy {
                  * @param clientNb Number of clients connected
                  * @param map Reference to the game map server
                  * @param teamList Reference to the list of teams in the game
+                 * @param serializer Threads rendering large mct answers
+                 * @param profiler Receives the execution time of each command
                  */
             CommandHandlerGui(int &freq, int width, int height, int clientNb,
                 zappy::game::MapServer &map,
-                std::vector<std::shared_ptr<ITeams>> &teamList)
+                std::vector<std::shared_ptr<ITeams>> &teamList,
+                SerializePool &serializer, TickProfiler &profiler)
                 : _teamList(teamList), _freq(freq), _widthMap(width),
-                  _heightMap(height), _clientNb(clientNb), _map(map) {};
+                  _heightMap(height), _clientNb(clientNb), _map(map),
+                  _serializer(serializer), _profiler(profiler) {};
 
             /**
                  * @brief Default destructor
@@ -53,21 +61,7 @@ namespace zappy {
                  * @param player Reference to the server player object
                  */
             virtual void processClientInput(
-                std::string &input, zappy::game::ServerPlayer &player);
-
-            /**
-                 * @brief Initialize the command map with GUI protocol commands
-                 */
-            virtual void initCommandMap();
-
-            /**
-                 * @brief Command map for GUI protocol commands
-                 * 
-                 * Maps command strings to their corresponding handler functions
-                 */
-            std::unordered_map<std::string,
-                std::function<void(ServerPlayer &, const std::string &)>>
-                _commandMapGui;
+                std::string_view input, zappy::game::ServerPlayer &player);
 
             /**
                  * @brief Reference to the list of teams in the game
@@ -87,7 +81,8 @@ namespace zappy {
             /**
                  * @brief Handle tile content command (bct)
                  * 
-                 * Sends the content of a specific tile to the GUI client.
+                 * Sends the content of a specific tile to the GUI client,
+                 * read from a map view.
                  * Response format: "bct X Y q0 q1 q2 q3 q4 q5 q6\n"
                  * where X,Y are coordinates and q0-q6 are resource quantities
                  * 
@@ -95,12 +90,16 @@ namespace zappy {
                  * @param arg Arguments containing tile coordinates "X Y"
                  */
             void handleBct(
-                zappy::game::ServerPlayer &player, const std::string &arg);
+                zappy::game::ServerPlayer &player, std::string_view arg);
 
             /**
                  * @brief Handle map content command (mct)
                  * 
-                 * Sends the content of all tiles on the map to the GUI client.
+                 * Sends the content of all tiles on the map to the GUI client,
+                 * every line read from the same map view. Large maps are
+                 * rendered by the SerializePool: the output of the GUI is
+                 * held meanwhile, so the answer keeps its place among the
+                 * messages, and its next commands wait for it.
                  * Response format: Multiple "bct X Y q0 q1 q2 q3 q4 q5 q6\n" lines
                  * 
                  * @param player Reference to the GUI player requesting map content
@@ -139,7 +138,7 @@ namespace zappy {
                  * @param arg Arguments containing player number "#n"
                  */
             void handlePpo(
-                zappy::game::ServerPlayer &player, const std::string &arg);
+                zappy::game::ServerPlayer &player, std::string_view arg);
 
             /**
                  * @brief Handle player level command (plv)
@@ -152,7 +151,7 @@ namespace zappy {
                  * @param arg Arguments containing player number "#n"
                  */
             void handlePlv(
-                zappy::game::ServerPlayer &player, const std::string &arg);
+                zappy::game::ServerPlayer &player, std::string_view arg);
 
             /**
                  * @brief Handle player inventory command (pin)
@@ -165,7 +164,7 @@ namespace zappy {
                  * @param arg Arguments containing player number "#n"
                  */
             void handlePin(
-                zappy::game::ServerPlayer &player, const std::string &arg);
+                zappy::game::ServerPlayer &player, std::string_view arg);
 
             /**
                  * @brief Handle server time unit get command (sgt)
@@ -187,9 +186,80 @@ namespace zappy {
                  * @param arg Arguments containing new time unit value "T"
                  */
             void handleSst(
-                zappy::game::ServerPlayer &player, const std::string &arg);
+                zappy::game::ServerPlayer &player, std::string_view arg);
+
+            /**
+                 * @brief Handle team stats command (tst)
+                 * 
+                 * Sends the level histogram of every team, or of the team
+                 * named in the argument. Response format: one
+                 * "tst N P L1 L2 L3 L4 L5 L6 L7 L8\n" line per team, where
+                 * N=team name, P=players and Ln=players at level n
+                 * 
+                 * @param player Reference to the GUI player requesting the stats
+                 * @param arg Optional team name
+                 */
+            void handleTst(
+                zappy::game::ServerPlayer &player, std::string_view arg);
+
+            /**
+                 * @brief Send a pnw line describing a player to one GUI
+                 * 
+                 * @param gui Reference to the GUI player to notify
+                 * @param player Player to describe
+                 */
+            void sendPnw(zappy::game::ServerPlayer &gui,
+                const zappy::game::ServerPlayer &player);
+
+            /**
+                 * @brief Send a bct line for one tile to one GUI
+                 * 
+                 * Reads the live tile, the caller holds the lock of its shard.
+                 * 
+                 * @param gui Reference to the GUI player to notify
+                 * @param x X coordinate of the tile, inside the map
+                 * @param y Y coordinate of the tile, inside the map
+                 */
+            void sendBct(zappy::game::ServerPlayer &gui, int x, int y);
+
+            /**
+                 * @brief Send a plv line for a player to one GUI
+                 * 
+                 * @param gui Reference to the GUI player to notify
+                 * @param player Player whose level is sent
+                 */
+            void sendPlv(zappy::game::ServerPlayer &gui,
+                const zappy::game::ServerPlayer &player);
+
+            /**
+                 * @brief Send a pin line for a player to one GUI
+                 * 
+                 * @param gui Reference to the GUI player to notify
+                 * @param player Player whose inventory is sent
+                 */
+            void sendPin(zappy::game::ServerPlayer &gui,
+                const zappy::game::ServerPlayer &player);
 
            protected:
+            /**
+                     * @brief Find a player from a "#n" or "n" argument
+                     * 
+                     * @param arg Argument holding the player number
+                     * @return std::shared_ptr<ServerPlayer> The player, or nullptr if unknown
+                     */
+            std::shared_ptr<ServerPlayer> _findPlayer(std::string_view arg);
+
+            /**
+                     * @brief Send a bct line built from given quantities
+                     * 
+                     * @param gui Reference to the GUI player to notify
+                     * @param x X coordinate of the tile
+                     * @param y Y coordinate of the tile
+                     * @param quantities Quantity of each resource on the tile
+                     */
+            void _sendBct(zappy::game::ServerPlayer &gui, size_t x, size_t y,
+                const std::array<size_t, RESOURCE_QUANTITY> &quantities);
+
             /**
                      * @brief Reference to the game frequency (time units per second)
                      */
@@ -216,13 +286,14 @@ namespace zappy {
             MapServer &_map;
 
             /**
-                     * @brief Command map for protocol commands
-                     * 
-                     * Maps command strings to their corresponding handler functions
+                     * @brief Threads rendering large mct answers
+                     */
+            SerializePool &_serializer;
+
+            /**
+                     * @brief Execution time of every command
                      */
-            std::unordered_map<std::string,
-                std::function<void(ServerPlayer &, const std::string &)>>
-                _commandMap;
+            TickProfiler &_profiler;
         };
     }  // namespace game
 }  // namespace zappy
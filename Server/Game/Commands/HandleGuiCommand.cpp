@@ -7,63 +7,95 @@
 
 #include "GuiCommand.hpp"
 
+std::shared_ptr<zappy::game::ServerPlayer>
+zappy::game::CommandHandlerGui::_findPlayer(std::string_view arg)
+{
+    int playerId = 0;
+
+    if (!zappy::server::parseInt(arg, playerId))
+        return nullptr;
+    for (auto &team : this->_teamList) {
+        auto lock = team->lockPlayerList();
+        for (auto &p : team->getPlayerListRef()) {
+            if (p && p->getId() == playerId)
+                return p;
+        }
+    }
+    return nullptr;
+}
+
 void zappy::game::CommandHandlerGui::handleMsz(
     zappy::game::ServerPlayer &player)
 {
-    std::string msg = "msz " + std::to_string(this->_widthMap) + " " +
-                      std::to_string(this->_heightMap) + "\n";
-    player.getClient().sendMessage(msg);
+    player.getClient().sendFormatted(
+        "msz ", this->_widthMap, ' ', this->_heightMap, '\n');
+}
+
+void zappy::game::CommandHandlerGui::sendPnw(
+    zappy::game::ServerPlayer &gui, const zappy::game::ServerPlayer &player)
+{
+    gui.getClient().sendFormatted("pnw #", player.getId(), ' ', player.x,
+        ' ', player.y, ' ', static_cast<int>(player.orientation) + 1, ' ',
+        player.level, ' ', player.teamName, '\n');
 }
 
 void zappy::game::CommandHandlerGui::handlePnw(zappy::game::ServerPlayer &gui)
 {
     for (auto &team : this->_teamList) {
-        auto teamsPlayer =
-            std::dynamic_pointer_cast<zappy::game::TeamsPlayer>(team);
-
-        if (teamsPlayer && !teamsPlayer->getPlayerList().empty()) {
-            for (auto &player : teamsPlayer->getPlayerList()) {
-
-                gui.getClient().sendMessage(
-                    "pnw #" + std::to_string(player->getId()) + " " +
-                    std::to_string(player->x) + " " +
-                    std::to_string(player->y) + " " +
-                    std::to_string(static_cast<int>(player->orientation + 1)) +
-                    " " + std::to_string(player->level) + " " +
-                    player->teamName + "\n");
-            }
-        }
+        if (!dynamic_cast<zappy::game::TeamsPlayer *>(team.get()))
+            continue;
+        team->forEachPlayer(
+            [this, &gui](ServerPlayer &player) { this->sendPnw(gui, player); });
     }
 }
 
+void zappy::game::CommandHandlerGui::sendBct(
+    zappy::game::ServerPlayer &gui, int x, int y)
+{
+    this->_sendBct(gui, x, y, this->_map.getTile(x, y).getResources());
+}
+
+void zappy::game::CommandHandlerGui::_sendBct(zappy::game::ServerPlayer &gui,
+    size_t x, size_t y, const std::array<size_t, RESOURCE_QUANTITY> &quantities)
+{
+    gui.getClient().sendFormatted("bct ", x, ' ', y, ' ', quantities[0], ' ',
+        quantities[1], ' ', quantities[2], ' ', quantities[3], ' ',
+        quantities[4], ' ', quantities[5], ' ', quantities[6], '\n');
+}
+
 void zappy::game::CommandHandlerGui::handleBct(
-    zappy::game::ServerPlayer &player, const std::string &arg)
-{
-    std::istringstream iss(arg);
-    int x;
-    int y;
-    std::string leftover;
-    std::string msg = "bct ";
-
-    if (iss >> x >> y && !(iss >> leftover) &&
-        (x <= this->_widthMap && x >= 0) &&
-        (y <= this->_heightMap && y >= 0)) {
-        msg += std::to_string(x) + " " + std::to_string(y);
-        for (auto resource : this->_map.getTile(x, y).getResources())
-            msg += " " + std::to_string(resource);
-        msg += "\n";
-        player.getClient().sendMessage(msg);
-    } else
+    zappy::game::ServerPlayer &player, std::string_view arg)
+{
+    std::string_view args = arg;
+    int x = 0;
+    int y = 0;
+
+    if (zappy::server::parseInt(args, x) && zappy::server::parseInt(args, y) &&
+        args.find_first_not_of(' ') == std::string_view::npos &&
+        (x < this->_widthMap && x >= 0) && (y < this->_heightMap && y >= 0))
+        this->_sendBct(player, x, y, this->_map.acquireView()->getResources(x, y));
+    else
         player.getClient().sendMessage("ko\n");
 }
 
 void zappy::game::CommandHandlerGui::handleMct(
     zappy::game::ServerPlayer &player)
 {
-    for (int x = 0; x < this->_widthMap; x += 1) {
-        for (int y = 0; y < this->_heightMap; y += 1)
-            this->handleBct(player,
-                std::string(std::to_string(x) + " " + std::to_string(y)));
+    auto view = this->_map.acquireView();
+
+    if (view->getWidth() * view->getHeight() > SerializePool::tilesPerPart) {
+        zappy::server::Client client = player.getClient();
+
+        client.holdOutput();
+        this->_serializer.renderTiles(std::move(view),
+            [client](std::string &&tiles) mutable {
+                client.releaseOutput(tiles);
+            });
+        return;
+    }
+    for (size_t x = 0; x < view->getWidth(); x += 1) {
+        for (size_t y = 0; y < view->getHeight(); y += 1)
+            this->_sendBct(player, x, y, view->getResources(x, y));
     }
 }
 
@@ -72,111 +104,92 @@ void zappy::game::CommandHandlerGui::handleTna(
 {
     for (auto &team : this->_teamList) {
         if (team->getName() != "GRAPHIC")
-            player.getClient().sendMessage(
-                std::string("tna " + team->getName() + "\n"));
+            player.getClient().sendFormatted("tna ", team->getName(), '\n');
     }
 }
 
 void zappy::game::CommandHandlerGui::handlePpo(
-    zappy::game::ServerPlayer &player, const std::string &arg)
+    zappy::game::ServerPlayer &player, std::string_view arg)
 {
-    std::stringstream stream;
-    int playerId;
-    std::string msg = "ppo #";
+    auto target = this->_findPlayer(arg);
 
-    stream << arg;
-    stream >> playerId;
+    if (!target)
+        return player.getClient().sendMessage("ko\n");
+    player.getClient().sendFormatted("ppo #", target->getId(), ' ', target->x,
+        ' ', target->y, ' ', static_cast<int>(target->orientation) + 1, '\n');
+}
 
-    for (auto &team : this->_teamList) {
-        for (auto &p : team->getPlayerList()) {
-            if (p->getId() == playerId) {
-                std::string msg =
-                    msg + std::to_string(playerId) + " " +
-                    std::to_string(p->x) + " " + std::to_string(p->y) + " " +
-                    std::to_string(static_cast<int>(player.orientation) + 1) +
-                    "\n";
-
-                player.getClient().sendMessage(msg);
-                return;
-            }
-        }
-    }
-    player.getClient().sendMessage("ko\n");
+void zappy::game::CommandHandlerGui::sendPlv(
+    zappy::game::ServerPlayer &gui, const zappy::game::ServerPlayer &player)
+{
+    gui.getClient().sendFormatted(
+        "plv #", player.getId(), ' ', player.level, '\n');
 }
 
 void zappy::game::CommandHandlerGui::handlePlv(
-    zappy::game::ServerPlayer &player, const std::string &arg)
+    zappy::game::ServerPlayer &player, std::string_view arg)
 {
-    std::stringstream stream;
-    int playerId;
-    std::string msg = "plv #";
+    auto target = this->_findPlayer(arg);
 
-    stream << arg;
-    stream >> playerId;
+    if (!target)
+        return player.getClient().sendMessage("ko\n");
+    this->sendPlv(player, *target);
+}
 
-    for (auto &team : this->_teamList) {
-        for (auto &p : team->getPlayerList()) {
-            if (p->getId() == playerId) {
-                msg += std::to_string(playerId) + " " +
-                       std::to_string(p->level) + "\n";
-                player.getClient().sendMessage(msg);
-                std::cout << "LEVEL : " << p->level << std::endl;
-                return;
-            }
-        }
-    }
-    player.getClient().sendMessage("ko\n");
+void zappy::game::CommandHandlerGui::sendPin(
+    zappy::game::ServerPlayer &gui, const zappy::game::ServerPlayer &player)
+{
+    const auto &quantities = player.getInventory().getResources();
+
+    gui.getClient().sendFormatted("pin #", player.getId(), ' ', player.x, ' ',
+        player.y, ' ', quantities[0], ' ', quantities[1], ' ', quantities[2],
+        ' ', quantities[3], ' ', quantities[4], ' ', quantities[5], ' ',
+        quantities[6], '\n');
 }
 
 void zappy::game::CommandHandlerGui::handlePin(
-    zappy::game::ServerPlayer &player, const std::string &arg)
+    zappy::game::ServerPlayer &player, std::string_view arg)
 {
-    std::stringstream stream;
-    int playerId;
-    std::string msg = "pin #";
+    auto target = this->_findPlayer(arg);
 
-    stream << arg;
-    stream >> playerId;
-
-    for (auto &team : this->_teamList) {
-        for (auto &p : team->getPlayerList()) {
-            if (p->getId() == playerId) {
-                msg += std::to_string(playerId) + " " + std::to_string(p->x) +
-                       " " + std::to_string(p->y) + " ";
-                zappy::game::Inventory playerInv = p->getInventory();
-                for (auto foodName : names)
-                    msg += std::to_string(playerInv.getResourceQuantity(
-                               getResource(foodName))) +
-                           " ";
-                msg.pop_back();
-                msg += "\n";
-                player.getClient().sendMessage(msg);
-                return;
-            }
-        }
-    }
-    player.getClient().sendMessage("ko\n");
+    if (!target)
+        return player.getClient().sendMessage("ko\n");
+    this->sendPin(player, *target);
 }
 
 void zappy::game::CommandHandlerGui::handleSgt(
     zappy::game::ServerPlayer &player)
 {
-    player.getClient().sendMessage(
-        std::string("sgt ") + std::to_string(this->_freq) + "\n");
+    player.getClient().sendFormatted("sgt ", this->_freq, '\n');
 }
 
-void zappy::game::CommandHandlerGui::handleSst(
-    zappy::game::ServerPlayer &player, const std::string &arg)
+void zappy::game::CommandHandlerGui::handleTst(
+    zappy::game::ServerPlayer &player, std::string_view arg)
 {
-    std::stringstream stream;
-    int freq;
-    std::string msg = "sgt ";
+    std::string &msg = zappy::server::formatScratch();
 
-    stream << arg;
-    stream >> freq;
+    for (auto &team : this->_teamList) {
+        if (team->getName() == "GRAPHIC" ||
+            (!arg.empty() && team->getName() != arg))
+            continue;
+        auto stats = team->getStats();
+        zappy::server::formatTo(msg, "tst ", team->getName(), ' ',
+            stats.players);
+        for (auto count : stats.levels)
+            zappy::server::formatTo(msg, ' ', count);
+        zappy::server::formatTo(msg, '\n');
+    }
+    player.getClient().sendMessage(msg.empty() ? "sbp\n" : msg);
+}
 
-    this->_freq = freq;
+void zappy::game::CommandHandlerGui::handleSst(
+    zappy::game::ServerPlayer &player, std::string_view arg)
+{
+    std::string_view args = arg;
+    int freq = 0;
 
-    player.getClient().sendMessage(msg + std::to_string(this->_freq) + "\n");
+    if (!zappy::server::parseInt(args, freq) || freq <= 0)
+        return player.getClient().sendMessage("sbp\n");
+    this->_freq = freq;
+    player.getClient().sendFormatted("sst ", this->_freq, '\n');
 }
-
@@ -10,32 +10,7 @@
 std::vector<std::weak_ptr<zappy::game::ServerPlayer>>
 zappy::game::CommandHandler::_getPlayersForIncant(int x, int y, size_t level)
 {
-    std::vector<std::weak_ptr<ServerPlayer>> players;
-
-    for (auto &team : this->_teamList) {
-        for (auto &player : team->getPlayerList()) {
-            if (player->x == x && player->y == y && player->level == level) {
-                players.push_back(player);
-            }
-        }
-    }
-    return players;
-}
-
-std::vector<std::weak_ptr<zappy::game::ServerPlayer>>
-zappy::game::CommandHandler::_getPlayersIncanting(int x, int y, size_t level)
-{
-    std::vector<std::weak_ptr<ServerPlayer>> players;
-
-    for (auto &team : this->_teamList) {
-        for (auto &player : team->getPlayerList()) {
-            if (player->x == x && player->y == y && player->isPraying() &&
-                player->level == level) {
-                players.push_back(player);
-            }
-        }
-    }
-    return players;
+    return this->_players.playersOnTile(x, y, level);
 }
 
 bool zappy::game::CommandHandler::_checkIncantationResources(
@@ -44,6 +19,7 @@ bool zappy::game::CommandHandler::_checkIncantationResources(
     if (level < minLevel || level >= maxLevel)
         return false;
 
+    std::lock_guard<std::mutex> lock(this->_map.getTileMutex(x, y));
     auto &tile = this->_map.getTile(x, y);
     const auto &requirements = elevationRequirements[level - 1];
 
@@ -59,30 +35,20 @@ bool zappy::game::CommandHandler::_checkIncantationResources(
                requirements.thystame;
 }
 
-bool zappy::game::CommandHandler::_checkIncantationConditions(
-    const zappy::game::ServerPlayer &player)
-{
-    const auto &requirements = elevationRequirements[player.level - 1];
-
-    if (player.level >= maxLevel) {
-        return false;
-    }
-    auto players =
-        this->_getPlayersForIncant(player.x, player.y, player.level);
-
-    if (players.size() < requirements.players) {
-        return false;
-    }
-    return this->_checkIncantationResources(player.x, player.y, player.level);
-}
-
-void zappy::game::CommandHandler::_consumeElevationResources(
+bool zappy::game::CommandHandler::_consumeElevationResources(
     size_t x, size_t y, size_t level)
 {
-    std::lock_guard<std::mutex> lock(this->_map._resourceMutex);
+    std::lock_guard<std::mutex> lock(this->_map.getTileMutex(x, y));
     auto &tile = this->_map.getTile(x, y);
     const auto &req = elevationRequirements[level - 1];
 
+    if (tile.getResourceQuantity(Resource::LINEMATE) < req.linemate ||
+        tile.getResourceQuantity(Resource::DERAUMERE) < req.deraumere ||
+        tile.getResourceQuantity(Resource::SIBUR) < req.sibur ||
+        tile.getResourceQuantity(Resource::MENDIANE) < req.mendiane ||
+        tile.getResourceQuantity(Resource::PHIRAS) < req.phiras ||
+        tile.getResourceQuantity(Resource::THYSTAME) < req.thystame)
+        return false;
     for (size_t i = 0; i < req.linemate; i += 1)
         tile.removeResource(Resource::LINEMATE);
     for (size_t i = 0; i < req.deraumere; i += 1)
@@ -95,97 +61,82 @@ void zappy::game::CommandHandler::_consumeElevationResources(
         tile.removeResource(Resource::PHIRAS);
     for (size_t i = 0; i < req.thystame; i += 1)
         tile.removeResource(Resource::THYSTAME);
+    this->_map.markTileDirty(x, y);
+    return true;
 }
 
-void zappy::game::CommandHandler::_setPrayer(zappy::game::ServerPlayer &player)
-{
-    auto playersOnTile =
-        this->_getPlayersForIncant(player.x, player.y, player.level);
-    std::for_each(playersOnTile.begin(), playersOnTile.end(),
-        [](std::weak_ptr<ServerPlayer> playerOnTile) {
-            auto sharedPlayer = playerOnTile.lock();
-            if (!sharedPlayer)
-                throw GameError("Unable to lock weak ptr", "Allowing praying");
-            if (sharedPlayer->isInAction())
-                return;
-            sharedPlayer->setInAction(true);
-            sharedPlayer->pray();
-            sharedPlayer->getClient().sendMessage("Elevation underway\n");
-        });
-}
-
-void zappy::game::CommandHandler::_elevatePlayer(zappy::game::ServerPlayer &player)
-{
-    auto playersOnTile = this->_getPlayersIncanting(player.x, player.y, player.level);
-    
-    for (auto &playerPtr : playersOnTile) {
-        auto sharedPlayer = playerPtr.lock();
-        if (!sharedPlayer || !sharedPlayer->isPraying()) {
-            continue;
-        }
-        sharedPlayer->level += 1;
-        sharedPlayer->stopPraying();
-        sharedPlayer->setInAction(false);
-
-        std::string msg = std::string("Current level: ") + 
-                         std::to_string(sharedPlayer->level) + "\n";
-        sharedPlayer->getClient().sendMessage(msg);
-        
-        std::cout << "Player " << sharedPlayer->getClient().getSocket() 
-                 << " elevated to level " << sharedPlayer->level << std::endl;
-    }
-}
-
-void zappy::game::CommandHandler::incantationPrinting(zappy::game::ServerPlayer &player)
+void zappy::game::CommandHandler::interruptIncantation(
+    zappy::game::ServerPlayer &player)
 {
-    std::string guiMsg = "pic " + std::to_string(player.x) + " " +
-                         std::to_string(player.y) + " " +
-                         std::to_string(player.level) + " #" +
-                         std::to_string(player.getId());
-    auto otherPlayers =
-        this->_getPlayersForIncant(player.x, player.y, player.level);
+    auto released = this->_incantations.interrupt(player.getId());
 
-    std::for_each(otherPlayers.begin(), otherPlayers.end(),
-        [&guiMsg](std::weak_ptr<ServerPlayer> player) {
-            auto sharedPlayer = player.lock();
-            if (!sharedPlayer->isPraying())
-                return;
-            guiMsg += " #";
-            guiMsg += sharedPlayer->getId();
-        });
-    guiMsg += "\n";
-    this->messageToGUI(guiMsg);
-    if (!this->_waitCommand(player, timeLimit::INCANTATION))
+    if (!released)
         return;
-    if (!this->_checkIncantationConditions(player)) {
-        this->messageToGUI(
-            std::string("pie " + std::to_string(player.x) + " " +
-                        std::to_string(player.y) + " 0\n"));
-        player.setInAction(false);
-        player.stopPraying();
-        return player.getClient().sendMessage("ko\n");
-    }
-    player.pray();}
+    released->stopPraying();
+    released->setInAction(false);
+    released->getClient().sendMessage("ko\n");
+}
 
+/**
+ * @brief Run an incantation as a session
+ *
+ * The participants are captured with a single scan of the players when
+ * the incantation starts. Ejections and deaths remove them from the
+ * session as they happen, so the outcome only depends on the session and
+ * on the resources still on the tile.
+ *
+ * @param player Player casting the incantation
+ */
 void zappy::game::CommandHandler::handleIncantation(
     zappy::game::ServerPlayer &player)
 {
-    if (!this->_checkIncantationConditions(player)) {
-        this->messageToGUI(
-            std::string("pie " + std::to_string(player.x) + " " +
-                        std::to_string(player.y) + " 0\n"));
+    if (!this->_checkIncantationResources(player.x, player.y, player.level)) {
+        this->messageToGUI("pie ", player.x, ' ', player.y, " 0\n");
+        return player.getClient().sendMessage("ko\n");
+    }
+    const auto &req = elevationRequirements[player.level - 1];
+    auto session = this->_incantations.open(player,
+        this->_getPlayersForIncant(player.x, player.y, player.level),
+        req.players);
+    if (!session) {
+        this->messageToGUI("pie ", player.x, ' ', player.y, " 0\n");
         return player.getClient().sendMessage("ko\n");
     }
-    this->_setPrayer(player);
-    this->incantationPrinting(player);
-    this->messageToGUI(std::string("pie " + std::to_string(player.x) + " " +
-                                   std::to_string(player.y) + " 1\n"));
-    this->messageToGUI(std::string("plv #" + std::to_string(player.getId()) + " " +
-                                   std::to_string(player.level + 1) + "\n"));
-    this->_consumeElevationResources(player.x, player.y, player.level);
-    this->messageToGUI(std::string("pie " + std::to_string(player.x) + " " +
-                                   std::to_string(player.y) + " 1\n"));
-    this->_elevatePlayer(player);
-    player.setInAction(false);
-    player.stopPraying();
+
+    auto leader = session->participants.front().player.lock();
+    std::string guiMsg;
+    zappy::server::formatTo(guiMsg, "pic ", session->x, ' ', session->y, ' ',
+        session->level);
+    for (auto &participant : this->_incantations.getPlayers(session)) {
+        participant->pray();
+        participant->getClient().sendMessage("Elevation underway\n");
+        zappy::server::formatTo(guiMsg, " #", participant->getId());
+    }
+    this->messageToGUI(guiMsg, '\n');
+
+    bool completed = this->_waitCommand(player, timeLimit::INCANTATION);
+    auto participants = this->_incantations.close(session);
+    bool success = completed && !session->leaderLost &&
+        participants.size() >= req.players &&
+        this->_consumeElevationResources(session->x, session->y,
+            session->level);
+
+    this->messageToGUI("pie ", session->x, ' ', session->y,
+        success ? " 1\n" : " 0\n");
+    for (auto &participant : participants) {
+        participant->stopPraying();
+        if (success) {
+            participant->getTeam().elevatePlayer(*participant);
+            this->_players.sync(*participant);
+            participant->getClient().sendFormatted(
+                "Current level: ", participant->level, '\n');
+            this->messageToGUI("plv #", participant->getId(), ' ',
+                participant->level, '\n');
+        } else
+            participant->getClient().sendMessage("ko\n");
+        if (participant.get() != &player)
+            participant->setInAction(false);
+    }
+    if (session->leaderLost && leader)
+        leader->getClient().sendMessage("ko\n");
 }
@@ -0,0 +1,123 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** IncantationSession
+*/
+
+#include "IncantationSession.hpp"
+#include "ServerPlayer.hpp"
+#include <algorithm>
+
+std::shared_ptr<zappy::game::IncantationSession>
+zappy::game::IncantationRegistry::open(const ServerPlayer &leader,
+    const std::vector<std::weak_ptr<ServerPlayer>> &candidates,
+    size_t requiredPlayers)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto session = std::make_shared<IncantationSession>();
+    auto tile = this->_byTile.find(_tileKey(leader.x, leader.y));
+
+    if (tile != this->_byTile.end() &&
+        std::any_of(tile->second.begin(), tile->second.end(),
+            [&leader](const std::shared_ptr<IncantationSession> &running) {
+                return running->level == leader.level;
+            }))
+        return nullptr;
+    session->x = leader.x;
+    session->y = leader.y;
+    session->level = leader.level;
+    std::vector<std::shared_ptr<ServerPlayer>> others;
+    bool leaderFound = false;
+
+    session->participants.push_back({static_cast<int>(leader.getId()), {}});
+    for (auto &candidate : candidates) {
+        auto player = candidate.lock();
+        if (!player || this->_byPlayer.count(player->getId()))
+            continue;
+        if (player.get() == &leader) {
+            session->participants.front().player = player;
+            leaderFound = true;
+        } else if (player->tryReserve()) {
+            session->participants.push_back(
+                {static_cast<int>(player->getId()), player});
+            others.push_back(player);
+        }
+    }
+    if (!leaderFound || session->participants.size() < requiredPlayers) {
+        for (auto &player : others)
+            player->setInAction(false);
+        return nullptr;
+    }
+
+    for (auto &participant : session->participants)
+        this->_byPlayer[participant.id] = session;
+    this->_byTile[_tileKey(session->x, session->y)].push_back(session);
+    return session;
+}
+
+std::vector<std::shared_ptr<zappy::game::ServerPlayer>>
+zappy::game::IncantationRegistry::getPlayers(
+    const std::shared_ptr<IncantationSession> &session)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    std::vector<std::shared_ptr<ServerPlayer>> players;
+
+    for (auto &participant : session->participants) {
+        if (auto player = participant.player.lock())
+            players.push_back(player);
+    }
+    return players;
+}
+
+std::shared_ptr<zappy::game::ServerPlayer>
+zappy::game::IncantationRegistry::interrupt(int playerId)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_byPlayer.find(playerId);
+
+    if (it == this->_byPlayer.end())
+        return nullptr;
+    auto session = it->second;
+    this->_byPlayer.erase(it);
+
+    auto &participants = session->participants;
+    auto participant = std::find_if(participants.begin(), participants.end(),
+        [playerId](const IncantationSession::Participant &p) {
+            return p.id == playerId;
+        });
+    if (participant == participants.end())
+        return nullptr;
+    if (participant == participants.begin()) {
+        session->leaderLost = true;
+        participant->player.reset();
+        return nullptr;
+    }
+    auto player = participant->player.lock();
+    participants.erase(participant);
+    return player;
+}
+
+std::vector<std::shared_ptr<zappy::game::ServerPlayer>>
+zappy::game::IncantationRegistry::close(
+    const std::shared_ptr<IncantationSession> &session)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    std::vector<std::shared_ptr<ServerPlayer>> players;
+
+    for (auto &participant : session->participants) {
+        this->_byPlayer.erase(participant.id);
+        if (auto player = participant.player.lock())
+            players.push_back(player);
+    }
+
+    auto tile = this->_byTile.find(_tileKey(session->x, session->y));
+    if (tile != this->_byTile.end()) {
+        auto &sessions = tile->second;
+        sessions.erase(std::remove(sessions.begin(), sessions.end(), session),
+            sessions.end());
+        if (sessions.empty())
+            this->_byTile.erase(tile);
+    }
+    return players;
+}
@@ -0,0 +1,123 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** IncantationSession
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace zappy {
+    namespace game {
+        class ServerPlayer;
+
+        /**
+         * @brief An incantation running on a tile
+         *
+         * The participants are captured once when the incantation starts,
+         * the leader first. A participant that is ejected or dies leaves
+         * the session, so the outcome never needs to look at the other
+         * players again.
+         */
+        struct IncantationSession {
+            /**
+             * @brief A player taking part in the incantation
+             */
+            struct Participant {
+                int id;                              /**< Player id */
+                std::weak_ptr<ServerPlayer> player;  /**< Player, gone on disconnection */
+            };
+
+            int x;                                  /**< X coordinate of the tile */
+            int y;                                  /**< Y coordinate of the tile */
+            size_t level;                           /**< Level of the participants */
+            std::vector<Participant> participants;  /**< Remaining participants, leader first */
+            bool leaderLost = false;                /**< The leader was interrupted */
+        };
+
+        /**
+         * @brief Incantations in progress, indexed by tile and by player
+         *
+         * A player takes part in at most one incantation at a time. Every
+         * operation only touches the participants of one session.
+         */
+        class IncantationRegistry {
+           public:
+            /**
+             * @brief Start an incantation led by a player
+             *
+             * Candidates already in a session or busy with another command
+             * are left out. The others are reserved with
+             * ServerPlayer::tryReserve(), so that their own commands wait
+             * for the end of the incantation. Nothing is registered, and the
+             * reservations are dropped, when fewer than requiredPlayers
+             * remain or when an incantation of the same level already runs
+             * on the tile.
+             *
+             * @param leader Player casting the incantation, among candidates
+             * @param candidates Players of the leader level on the tile
+             * @param requiredPlayers Players needed by the incantation
+             * @return std::shared_ptr<IncantationSession> The session, null if
+             *         not enough players are available
+             */
+            std::shared_ptr<IncantationSession> open(const ServerPlayer &leader,
+                const std::vector<std::weak_ptr<ServerPlayer>> &candidates,
+                size_t requiredPlayers);
+
+            /**
+             * @brief Get the participants of a session
+             *
+             * @param session Running session
+             * @return std::vector<std::shared_ptr<ServerPlayer>> Participants
+             *         still in the session and connected, leader first
+             */
+            std::vector<std::shared_ptr<ServerPlayer>> getPlayers(
+                const std::shared_ptr<IncantationSession> &session);
+
+            /**
+             * @brief Remove a player from its incantation
+             *
+             * Called when the player is ejected or dies. The leader keeps
+             * its place in the session, marked as lost.
+             *
+             * @param playerId Id of the player
+             * @return std::shared_ptr<ServerPlayer> The player when it was a
+             *         participant other than the leader and is still
+             *         connected, so that the caller can release it
+             */
+            std::shared_ptr<ServerPlayer> interrupt(int playerId);
+
+            /**
+             * @brief End an incantation
+             *
+             * @param session Session to end
+             * @return std::vector<std::shared_ptr<ServerPlayer>> Participants
+             *         still in the session and connected, leader first
+             */
+            std::vector<std::shared_ptr<ServerPlayer>> close(
+                const std::shared_ptr<IncantationSession> &session);
+
+           private:
+            /**
+             * @brief Key of a tile in the registry
+             */
+            static size_t _tileKey(int x, int y)
+            {
+                return (static_cast<size_t>(static_cast<unsigned int>(y)) << 32) |
+                       static_cast<unsigned int>(x);
+            }
+
+            std::mutex _mutex;  /**< Guards both indexes and the sessions */
+            std::unordered_map<size_t, std::vector<std::shared_ptr<IncantationSession>>>
+                _byTile;        /**< Sessions running on each tile */
+            std::unordered_map<int, std::shared_ptr<IncantationSession>>
+                _byPlayer;      /**< Session of each participant */
+        };
+    }  // namespace game
+}  // namespace zappy
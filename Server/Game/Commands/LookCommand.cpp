@@ -6,14 +6,8 @@
 */
 
 #include "ClientCommand.hpp"
-
-std::pair<size_t, size_t> zappy::game::CommandHandler::_normalizeCoords(
-    size_t x, size_t y)
-{
-    x = ((x % this->_widthMap) + this->_widthMap) % this->_widthMap;
-    y = ((y % this->_heightMap) + this->_heightMap) % this->_heightMap;
-    return {static_cast<size_t>(x), static_cast<size_t>(y)};
-}
+#include "LookTable.hpp"
+#include "ShardLock.hpp"
 
 void zappy::game::CommandHandler::_getDirectionVector(
     const Player &player, int &dx, int &dy)
@@ -40,103 +34,57 @@ void zappy::game::CommandHandler::_getDirectionVector(
     }
 }
 
-std::pair<int, int> zappy::game::CommandHandler::_computeLookTarget(
-    zappy::game::ServerPlayer &player, size_t line, int offset)
+size_t zappy::game::CommandHandler::_countPlayersOnTile(int x, int y)
 {
-    Orientation orientation = player.orientation;
-    size_t playerX = player.x;
-    size_t playerY = player.y;
-    int dx = 0;
-    int dy = 0;
-
-    this->_getDirectionVector(player, dx, dy);
-
-    int targetX =
-        static_cast<int>(playerX) + dx * static_cast<int>(line) +
-        (orientation == Orientation::NORTH || orientation == Orientation::SOUTH
-                ? offset
-                : (dy * offset));
-
-    int targetY =
-        static_cast<int>(playerY) + dy * static_cast<int>(line) +
-        (orientation == Orientation::EAST || orientation == Orientation::WEST
-                ? offset
-                : (-dx * offset));
-
-    return {targetX, targetY};
+    return this->_players.countOnTile(x, y);
 }
 
-std::string zappy::game::CommandHandler::_getTileContent(
-    size_t x, size_t y, bool isPlayerTile)
+void zappy::game::CommandHandler::_appendTileContent(
+    std::string &msg, size_t x, size_t y, bool isPlayerTile)
 {
-    std::string content = "";
-    auto &tile = this->_map.getTile(x, y);
+    const auto &quantities = this->_map.getTile(x, y).getResources();
     bool hasContent = false;
-
-    auto playerList = this->_getPlayerOnTile(x, y);
-    for (auto it: playerList) {
-        content += " player";
-    }
-    for (const auto &resourceName : names) {
-        zappy::game::Resource resource = getResource(resourceName);
-        size_t quantity = tile.getResourceQuantity(resource);
-
-        for (size_t i = 0; i < quantity; ++i) {
-            if (isPlayerTile) {
-                content += " " + resourceName;
-                continue;
-            }
-            if (hasContent)
-                content += " ";
-            content += resourceName;
-            hasContent = true;
-        }
+    auto appendItem = [&msg, &hasContent, isPlayerTile](
+                          const std::string &item) {
+        if (isPlayerTile || hasContent)
+            msg.push_back(' ');
+        zappy::server::formatTo(msg, item);
+        hasContent = true;
+    };
+    static const std::string playerItem = "player";
+
+    for (size_t count = this->_countPlayersOnTile(x, y); count > 0; count -= 1)
+        appendItem(playerItem);
+    for (size_t idx = 0; idx < RESOURCE_QUANTITY; idx += 1) {
+        for (size_t i = 0; i < quantities[idx]; ++i)
+            appendItem(names[idx]);
     }
-
-    return content;
 }
 
-bool zappy::game::CommandHandler::_checkLastTileInLook(
-    size_t playerLevel, size_t line, int offset)
-{
-    return (line == playerLevel && offset == static_cast<int>(line));
-}
-
-std::string zappy::game::CommandHandler::_lookLine(
-    zappy::game::ServerPlayer &player, size_t line)
-{
-    std::string lineMsg = "";
-
-    for (int offset = static_cast<int>(line) * -1;
-        offset <= static_cast<int>(line); offset += 1) {
-        auto [targetX, targetY] =
-            this->_computeLookTarget(player, line, offset);
-        auto [normalizedX, normalizedY] =
-            this->_normalizeCoords(targetX, targetY);
-
-        std::string tileContent = this->_getTileContent(
-            normalizedX, normalizedY, line == 0 && offset == 0);
-        lineMsg += tileContent;
-
-        if (!this->_checkLastTileInLook(player.level, line, offset))
-            lineMsg += ",";
-    }
-
-    return lineMsg;
-}
-
-std::string zappy::game::CommandHandler::_buildLookMessage(
+const std::string &zappy::game::CommandHandler::_buildLookMessage(
     zappy::game::ServerPlayer &player)
 {
-    std::string msg = "[";
-    size_t playerLevel = player.level;
-
-    for (size_t line = 0; line <= playerLevel; line += 1) {
-        std::string lineMsg = this->_lookLine(player, line);
-        msg += lineMsg;
+    const auto &cone = lookCones[static_cast<size_t>(player.orientation)];
+    size_t tileCount = lookTileCount[std::min(player.level, maxLookLevel)];
+    int playerX = player.x;
+    int playerY = player.y;
+    std::string &msg = zappy::server::formatScratch();
+    ShardLock lock(this->_map);
+
+    for (size_t idx = 0; idx < tileCount; idx += 1)
+        lock.addTile(wrapCoord(playerX + cone[idx].dx, this->_widthMap),
+            wrapCoord(playerY + cone[idx].dy, this->_heightMap));
+    lock.lock();
+    msg.push_back('[');
+    for (size_t idx = 0; idx < tileCount; idx += 1) {
+        int targetX = wrapCoord(playerX + cone[idx].dx, this->_widthMap);
+        int targetY = wrapCoord(playerY + cone[idx].dy, this->_heightMap);
+
+        this->_appendTileContent(msg, targetX, targetY, idx == 0);
+        if (idx + 1 < tileCount)
+            msg.push_back(',');
     }
-
-    msg += "]\n";
+    zappy::server::formatTo(msg, "]\n");
     return msg;
 }
 
@@ -144,8 +92,7 @@ void zappy::game::CommandHandler::handleLook(zappy::game::ServerPlayer &player)
 {
     if (!this->_waitCommand(player, timeLimit::LOOK))
         return;
-    std::string msg = this->_buildLookMessage(player);
+    const std::string &msg = this->_buildLookMessage(player);
 
-    player.setInAction(false);
     player.getClient().sendMessage(msg);
 }
@@ -0,0 +1,111 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** LookTable
+*/
+
+#pragma once
+
+#include "Orientation.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace zappy {
+    namespace game {
+        /** @brief Highest level a player can see with (one cone line per level) */
+        constexpr size_t maxLookLevel = 8;
+
+        /** @brief Number of tiles seen by a player of level maxLookLevel */
+        constexpr size_t maxLookTiles = (maxLookLevel + 1) * (maxLookLevel + 1);
+
+        /**
+         * @brief Relative position of a tile inside the vision cone
+         */
+        struct LookOffset {
+            int dx; /**< Horizontal offset from the player tile */
+            int dy; /**< Vertical offset from the player tile */
+        };
+
+        /**
+         * @brief Vision cone of one orientation, in protocol order
+         *
+         * Line n of the cone holds 2n + 1 tiles, so the cone of a level L
+         * player is always the first (L + 1)^2 entries of this array: one
+         * table per orientation covers every level.
+         */
+        using LookCone = std::array<LookOffset, maxLookTiles>;
+
+        /**
+         * @brief Build the vision cone of an orientation at compile time
+         *
+         * @param orientation Orientation of the looking player
+         * @return LookCone Offsets of every visible tile, line by line
+         */
+        constexpr LookCone buildLookCone(Orientation orientation)
+        {
+            LookCone cone{};
+            size_t idx = 0;
+
+            for (int line = 0; line <= static_cast<int>(maxLookLevel);
+                line += 1) {
+                for (int offset = -line; offset <= line; offset += 1) {
+                    switch (orientation) {
+                        case Orientation::NORTH:
+                            cone[idx] = {offset, -line};
+                            break;
+                        case Orientation::EAST:
+                            cone[idx] = {line, offset};
+                            break;
+                        case Orientation::SOUTH:
+                            cone[idx] = {offset, line};
+                            break;
+                        case Orientation::WEST:
+                            cone[idx] = {-line, offset};
+                            break;
+                    }
+                    idx += 1;
+                }
+            }
+            return cone;
+        }
+
+        /**
+         * @brief Vision cones indexed by orientation
+         */
+        constexpr std::array<LookCone, 4> lookCones = {
+            buildLookCone(Orientation::NORTH),
+            buildLookCone(Orientation::EAST),
+            buildLookCone(Orientation::SOUTH),
+            buildLookCone(Orientation::WEST)};
+
+        /**
+         * @brief Number of visible tiles indexed by player level
+         */
+        constexpr std::array<size_t, maxLookLevel + 1> lookTileCount = {
+            1, 4, 9, 16, 25, 36, 49, 64, 81};
+
+        /**
+         * @brief Wrap a coordinate on a toroidal axis
+         *
+         * Cone offsets never exceed maxLookLevel, so on any map larger than
+         * that a single add or subtract is enough. The modulo fallback only
+         * runs on tiny maps.
+         *
+         * @param value Coordinate to wrap, possibly out of the map
+         * @param size Size of the axis
+         * @return int Coordinate in [0, size)
+         */
+        constexpr int wrapCoord(int value, int size)
+        {
+            if (value >= 0 && value < size)
+                return value;
+            if (value < 0 && value + size >= 0)
+                return value + size;
+            if (value >= size && value - size < size)
+                return value - size;
+            return ((value % size) + size) % size;
+        }
+    }  // namespace game
+}  // namespace zappy
@@ -6,20 +6,33 @@
 */
 
 #include "ClientCommand.hpp"
+#include "LookTable.hpp"
+#include "ShardLock.hpp"
+
+void zappy::game::CommandHandler::_positionToGUI(const ServerPlayer &player)
+{
+    this->messageToGUI("ppo #", player.getId(), ' ', player.x, ' ', player.y,
+        ' ', static_cast<int>(player.orientation) + 1, '\n');
+}
 
 void zappy::game::CommandHandler::handleForward(
     zappy::game::ServerPlayer &player)
 {
     if (!this->_waitCommand(player, timeLimit::FORWARD))
         return;
+    int dx = 0;
+    int dy = 0;
+    this->_getDirectionVector(player, dx, dy);
+    ShardLock lock(this->_map);
+
+    lock.addTile(player.x, player.y);
+    lock.addTile(wrapCoord(player.x + dx, this->_widthMap),
+        wrapCoord(player.y + dy, this->_heightMap));
+    lock.lock();
     player.stepForward(this->_widthMap, this->_heightMap);
-    player.setInAction(false);
+    this->_players.sync(player);
     player.getClient().sendMessage("ok\n");
-    std::string msg =
-        "ppo #" + std::to_string(player.getId()) + " " +
-        std::to_string(player.x) + " " + std::to_string(player.y) + " " +
-        std::to_string(static_cast<int>(player.orientation) + 1) + "\n";
-    this->messageToGUI(msg);
+    this->_positionToGUI(player);
 }
 
 void zappy::game::CommandHandler::handleRight(
@@ -28,13 +41,9 @@ void zappy::game::CommandHandler::handleRight(
     if (!this->_waitCommand(player, timeLimit::RIGHT))
         return;
     player.lookRight();
-    player.setInAction(false);
+    this->_players.sync(player);
     player.getClient().sendMessage("ok\n");
-    std::string msg =
-        "ppo #" + std::to_string(player.getId()) + " " +
-        std::to_string(player.x) + " " + std::to_string(player.y) + " " +
-        std::to_string(static_cast<int>(player.orientation) + 1) + "\n";
-    this->messageToGUI(msg);
+    this->_positionToGUI(player);
 }
 
 void zappy::game::CommandHandler::handleLeft(zappy::game::ServerPlayer &player)
@@ -42,11 +51,7 @@ void zappy::game::CommandHandler::handleLeft(zappy::game::ServerPlayer &player)
     if (!this->_waitCommand(player, timeLimit::LEFT))
         return;
     player.lookLeft();
-    player.setInAction(false);
+    this->_players.sync(player);
     player.getClient().sendMessage("ok\n");
-    std::string msg =
-        "ppo #" + std::to_string(player.getId()) + " " +
-        std::to_string(player.x) + " " + std::to_string(player.y) + " " +
-        std::to_string(static_cast<int>(player.orientation) + 1) + "\n";
-    this->messageToGUI(msg);
+    this->_positionToGUI(player);
 }
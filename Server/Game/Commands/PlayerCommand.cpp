@@ -15,14 +15,13 @@ void zappy::game::CommandHandler::handleConnectNbr(
     if (playerTeam) {
         int connectNbr =
             playerTeam->getClientNb() - playerTeam->getPlayerList().size();
-        player.setInAction(false);
-        player.getClient().sendMessage(std::to_string(connectNbr) + "\n");
+        player.getClient().sendFormatted(connectNbr, '\n');
     }
 }
 
 void zappy::game::CommandHandler::handleFork(zappy::game::ServerPlayer &player)
 {
-    this->messageToGUI("pfk #" + std::to_string(player.getId()) + "\n");
+    this->messageToGUI("pfk #", player.getId(), '\n');
     if (!this->_waitCommand(player, timeLimit::FORK))
         return;
 
@@ -32,11 +31,8 @@ void zappy::game::CommandHandler::handleFork(zappy::game::ServerPlayer &player)
         playerTeam->allowNewPlayer();
         std::lock_guard<std::mutex> eggLock (this->_map._eggMutex);
         auto eggId = this->_map.addNewEgg(playerTeam->getTeamId(), player.x, player.y);
-        player.setInAction(false);
-        this->messageToGUI(
-            "enw #" + std::to_string(eggId) + " #" +
-            std::to_string(player.getId()) + " " + std::to_string(player.x) +
-            " " + std::to_string(player.y) + "\n");
+        this->messageToGUI("enw #", eggId, " #", player.getId(), ' ',
+            player.x, ' ', player.y, '\n');
         player.getClient().sendMessage("ok\n");
     }
 }
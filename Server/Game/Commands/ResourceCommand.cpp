@@ -12,29 +12,25 @@ void zappy::game::CommandHandler::handleInventory(
 {
     if (!this->_waitCommand(player, timeLimit::INVENTORY))
         return;
-    zappy::game::Inventory playerInv = player.getInventory();
-    std::string msg = "[";
-    for (auto foodName : names)
-        msg += foodName + " " +
-               std::to_string(
-                   playerInv.getResourceQuantity(getResource(foodName))) +
-               ",";
-    msg.pop_back();
-    msg += "]\n";
-    player.setInAction(false);
+    const auto &quantities = player.getInventory().getResources();
+    std::string &msg = zappy::server::formatScratch();
+
+    for (size_t idx = 0; idx < RESOURCE_QUANTITY; idx += 1)
+        zappy::server::formatTo(msg, idx == 0 ? '[' : ',', names[idx], ' ',
+            quantities[idx]);
+    zappy::server::formatTo(msg, "]\n");
     player.getClient().sendMessage(msg);
 }
 
 void zappy::game::CommandHandler::resourceSendGui(zappy::game::ServerPlayer &player)
 {
     for (auto &team : this->_teamList) {
-        if (team->getName() == "GRAPHIC") {
-            for (auto &players : team->getPlayerList()) {
-                handlePin(*players, std::to_string(player.getId()));
-                handleBct(*players, std::string(std::to_string(player.x)) +
-                " " + std::string(std::to_string(player.y)));
-            }
-        }
+        if (team->getName() != "GRAPHIC")
+            continue;
+        team->forEachPlayer([this, &player](ServerPlayer &gui) {
+            this->sendPin(gui, player);
+            this->sendBct(gui, player.x, player.y);
+        });
     }
 }
 
@@ -49,7 +45,8 @@ void zappy::game::CommandHandler::handleTake(
     if (objectTake == names.end())
         return player.getClient().sendMessage("ko\n");
 
-    std::lock_guard<std::mutex> lock(this->_map._resourceMutex);
+    std::lock_guard<std::mutex> lock(
+        this->_map.getTileMutex(player.x, player.y));
     zappy::game::Resource resource = getResource(arg);
 
     auto &tile = this->_map.getTile(player.x, player.y);
@@ -58,10 +55,10 @@ void zappy::game::CommandHandler::handleTake(
 
     player.collectRessource(resource);
     tile.removeResource(resource);
-    player.setInAction(false);
+    this->_map.markTileDirty(player.x, player.y);
     player.getClient().sendMessage("ok\n");
-    this->messageToGUI("pgt #" + std::to_string(player.getId()) + " " +
-                       std::to_string(castResource(resource)) + "\n");
+    this->messageToGUI(
+        "pgt #", player.getId(), ' ', castResource(resource), '\n');
     this->resourceSendGui(player);
 }
 
@@ -76,7 +73,8 @@ void zappy::game::CommandHandler::handleDrop(
     if (objectDrop == names.end())
         return player.getClient().sendMessage("ko\n");
 
-    std::lock_guard<std::mutex> lock(this->_map._resourceMutex);
+    std::lock_guard<std::mutex> lock(
+        this->_map.getTileMutex(player.x, player.y));
     zappy::game::Resource resource = getResource(arg);
 
     auto &inventory = player.getInventory();
@@ -84,10 +82,10 @@ void zappy::game::CommandHandler::handleDrop(
         return player.getClient().sendMessage("ko\n");
 
     this->_map.getTile(player.x, player.y).addSingleResource(resource);
+    this->_map.markTileDirty(player.x, player.y);
     player.dropRessource(resource);
-    player.setInAction(false);
     player.getClient().sendMessage("ok\n");
-    this->messageToGUI("pdr #" + std::to_string(player.getId()) + " " +
-                       std::to_string(castResource(resource)) + "\n");
+    this->messageToGUI(
+        "pdr #", player.getId(), ' ', castResource(resource), '\n');
     this->resourceSendGui(player);
 }
@@ -18,11 +18,9 @@ const constexpr int nbOrientation = 4;
 std::shared_ptr<zappy::game::ServerPlayer> zappy::game::Game::_changeEggToPlayer(zappy::game::Orientation orientation,
     std::shared_ptr<zappy::game::ITeams> team, zappy::server::Client &user)
 {
-    zappy::game::Egg egg = this->_map.popEgg();
-    this->_commandHandler.messageToGUI(
-        "ebo #" + std::to_string(egg.getId()) + "\n");
-    this->_commandHandler.messageToGUI(
-        "edi #" + std::to_string(egg.getId()) + "\n");
+    zappy::game::Egg egg = this->_map.popEgg(team->getTeamId());
+    this->_commandHandler.messageToGUI("ebo #", egg.getId(), '\n');
+    this->_commandHandler.messageToGUI("edi #", egg.getId(), '\n');
     user.setState(zappy::server::ClientState::CONNECTED);
     auto newPlayer =
         std::make_shared<zappy::game::ServerPlayer>(std::move(user),
@@ -30,6 +28,7 @@ std::shared_ptr<zappy::game::ServerPlayer> zappy::game::Game::_changeEggToPlayer
     newPlayer->teamName = team->getName();
     this->_idPlayerTot += 1;
     team->addPlayer(newPlayer);
+    this->_players.add(newPlayer, this->_clock.now());
     this->_playerList.push_back(newPlayer);
     return newPlayer;
 }
@@ -37,33 +36,27 @@ std::shared_ptr<zappy::game::ServerPlayer> zappy::game::Game::_changeEggToPlayer
 void zappy::game::Game::_sendNewPlayerToGui(std::shared_ptr<zappy::game::ServerPlayer> &newPlayer)
 {
     for (auto &team : this->_teamList) {
-        if (team->getName() == "GRAPHIC") {
-            for (auto &guiPlayer : team->getPlayerList()) {
-                guiPlayer->getClient().sendMessage(
-                    "pnw #" + std::to_string(newPlayer->getId()) +
-                    " " + std::to_string(newPlayer->x) + " " +
-                    std::to_string(newPlayer->y) + " " +
-                    std::to_string(
-                        static_cast<int>(newPlayer->orientation + 1)) +
-                    " " + std::to_string(newPlayer->level) + " " +
-                    newPlayer->teamName + "\n");
-            }
-        }
+        if (team->getName() != "GRAPHIC")
+            continue;
+        team->forEachPlayer([this, &newPlayer](ServerPlayer &gui) {
+            this->_commandHandlerGui.sendPnw(gui, *newPlayer);
+        });
     }
 }
 
 void zappy::game::Game::_addPlayerToTeam(
     std::shared_ptr<zappy::game::ITeams> team, int clientSocket)
 {
-    std::srand(std::time({}));
-    int randVal = std::rand() % nbOrientation;
+    int randVal = this->_random.below(nbOrientation);
     zappy::game::Orientation orientation =
         static_cast<zappy::game::Orientation>(randVal);
-    zappy::server::Client user(clientSocket);
+    zappy::server::Client user(clientSocket, &this->_tickOutput);
     auto itPlayerTeam = std::dynamic_pointer_cast<TeamsPlayer>(team);
     try {
         if (itPlayerTeam) {
-            auto newPlayer = this->_changeEggToPlayer(orientation, team, user);
+            auto newPlayer = this->_takeRestoredPlayer(team, user);
+            if (!newPlayer)
+                newPlayer = this->_changeEggToPlayer(orientation, team, user);
             if (auto lastPlayer = this->_playerList.back().lock(); lastPlayer) {
                 if (lastPlayer->teamName == "GRAPHIC")
                     return;
@@ -90,14 +83,9 @@ bool zappy::game::Game::checkWin()
     for (auto &team : this->getTeamList()) {
         if (team->getName() == "GRAPHIC")
             continue;
-        int nbMaxLevel = 0;
-        for (auto &player : team->getPlayerList()) {
-            if (player->level >= winLevel)
-                nbMaxLevel += 1;
-        }
-        if (nbMaxLevel >= nbPlayerWinLevel) {
-            this->getCommandHandler().messageToGUI("seg " +
-                team->getName() + "\n");
+        if (team->countPlayersFromLevel(winLevel) >= nbPlayerWinLevel) {
+            this->getCommandHandler().messageToGUI(
+                "seg ", team->getName(), '\n');
             std::cout << "Team " << team->getName() << " has won !" << std::endl;
             return true;
         }
@@ -149,6 +137,7 @@ void zappy::game::Game::removeFromTeam(int clientSocket)
         auto &team = this->_teamList[i];
         for (auto &player : team->getPlayerList()) {
             if (player->getClient().getSocket() == clientSocket) {
+                this->_players.remove(*player);
                 team->removePlayer(clientSocket);
                 return;
             }
@@ -156,111 +145,188 @@ void zappy::game::Game::removeFromTeam(int clientSocket)
     }
 }
 
-void zappy::game::Game::removeFoodOrDiedPlayer(std::shared_ptr<zappy::game::ServerPlayer> &player,
-    std::shared_ptr<zappy::game::TeamsPlayer> itPlayerTeam)
+void zappy::game::Game::removeFoodOrDiedPlayer(std::shared_ptr<zappy::game::ServerPlayer> &player)
 {
     if (player->getInventory().getResourceQuantity(
             zappy::game::Resource::FOOD) > 0) {
         player->dropRessource(zappy::game::Resource::FOOD);
         for (auto &teams : _teamList) {
-            if (teams->getName() == "GRAPHIC") {
-                for (auto players : teams->getPlayerList())
-                    this->getCommandHandlerGui().handlePin(
-                        *players, std::to_string(player->getId()));
-            }
+            if (teams->getName() != "GRAPHIC")
+                continue;
+            teams->forEachPlayer([this, &player](ServerPlayer &gui) {
+                this->_commandHandlerGui.sendPin(gui, *player);
+            });
         }
-        player->resetLifeChrono();
+        this->_players.feed(*player, this->_clock.now());
     } else {
         std::cout << "Death of player: " << player->getId()
                     << std::endl;
         player->getClient().sendMessage("dead\n");
+        this->_commandHandler.interruptIncantation(*player);
+        this->_players.remove(*player);
         player->getTeam().removePlayer(
             player->getClient().getSocket());
-        this->_commandHandler.messageToGUI(
-            "pdi #" + std::to_string(player->getId()) + "\n");
-        itPlayerTeam->removePlayer(
-            player->getClient().getSocket());
+        this->_commandHandler.messageToGUI("pdi #", player->getId(), '\n');
     }
 }
 
-void zappy::game::Game::foodManager(std::shared_ptr<ITeams> &team)
+void zappy::game::Game::foodManager()
 {
-    constexpr int unitLose = 126;
-    double secondsBetweenFoodLoss =
-        static_cast<double>(unitLose) / this->_baseFreqMs;
-    auto loseFood = std::chrono::milliseconds(
-        static_cast<int>(secondsBetweenFoodLoss * 1000));
-    std::chrono::duration<double> loseFoodSeconds =
-        std::chrono::duration<double>(loseFood.count() / 1000.0);
-
-    auto itPlayerTeam = std::dynamic_pointer_cast<TeamsPlayer>(team);
-
-    if (itPlayerTeam) {
-        for (auto player : itPlayerTeam->getPlayerList()) {
-            if (!player || player->getClient().getState() ==
-                               server::ClientState::DISCONNECTED)
-                continue;
-            if (player->getLifeChrono() >= loseFoodSeconds) {
-                this->removeFoodOrDiedPlayer(player, itPlayerTeam);
-            }
-        }
+    this->_players.collectHungry(
+        this->_clock.now() - this->_mealInterval(), this->_hungry);
+    for (auto &player : this->_hungry) {
+        if (player->getClient().getState() != server::ClientState::DISCONNECTED)
+            this->removeFoodOrDiedPlayer(player);
     }
+    this->_hungry.clear();
 }
 
 void zappy::game::Game::gameLogic()
 {
     if (this->checkWin())
         this->setRunningState(zappy::RunningState::STOP);
-    for (auto &team : this->getTeamList()) {
-        this->foodManager(team);
-        for (auto &player : team->getPlayerList()) {
-            std::string clientInput = "";
-            {
-                std::lock_guard<std::mutex> lock(*(player->getClient().queueMutex));
-                if (player->getClient().queueMessage.empty())
-                    continue;
-                clientInput =
-                    player->getClient().queueMessage.front();
-            }
-            if (clientInput.empty() || clientInput == "")
-                continue;
-            if (player->teamName == "GRAPHIC") {
-                this->_commandHandlerGui.processClientInput(
-                    clientInput, *player);
-                continue;
-            }
-            this->_commandHandler.processClientInput(clientInput, *player);
+    std::string clientInput;
+
+    {
+        TickProfiler::ScopedPhase phase(this->_profiler, TickPhase::FOOD);
+
+        this->foodManager();
+    }
+    auto inboxStart = std::chrono::steady_clock::now();
+    auto commandTime = std::chrono::steady_clock::duration::zero();
+
+    const auto &players = this->_scheduler.plan(this->_teamList, this->_tick);
+
+    for (size_t idx = 0; idx < players.size(); idx += 1) {
+        auto &player = players[idx];
+
+        if (player->getClient().isOutputHeld() || !player->tryReserve())
+            continue;
+        if (!player->getClient().getInbox().pop(clientInput) ||
+            clientInput.empty()) {
+            player->setInAction(false);
+            continue;
         }
+        auto commandStart = std::chrono::steady_clock::now();
+
+        if (player->teamName == "GRAPHIC") {
+            this->_commandHandlerGui.processClientInput(clientInput, *player);
+            player->setInAction(false);
+        } else
+            this->_commandHandler.processClientInput(clientInput, *player);
+        auto elapsed = std::chrono::steady_clock::now() - commandStart;
+
+        commandTime += elapsed;
+        if (!this->_scheduler.charge(idx, elapsed))
+            break;
     }
+    this->_profiler.addPhase(TickPhase::COMMANDS, commandTime);
+    this->_profiler.addPhase(TickPhase::INBOX,
+        std::chrono::steady_clock::now() - inboxStart - commandTime);
 }
 
 void zappy::game::Game::runGame()
+{
+    this->startGame();
+    while (this->_isRunning != RunningState::STOP) {
+        this->step();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    this->stopGame();
+}
+
+void zappy::game::Game::startGame()
 {
     this->_isRunning = RunningState::RUN;
-    auto lastUpdate = std::chrono::steady_clock::now();
-    auto lastResourceRespawn = std::chrono::steady_clock::now();
+    this->_lastUpdate = this->_clock.now();
+    this->_lastResourceRespawn = this->_lastUpdate;
+}
 
-    while (this->_isRunning != RunningState::STOP) {
-        auto respawnInterval = std::chrono::duration<double>(
-            static_cast<double>(TIME_BEFORE_RESPAWN) / this->_baseFreqMs);
-        auto now = std::chrono::steady_clock::now();
-        auto elapsedTurn =
-            std::chrono::duration_cast<std::chrono::milliseconds>(
-                now - lastUpdate);
-        auto elapsedRespawn =
-            std::chrono::duration_cast<std::chrono::duration<double>>(
-                now - lastResourceRespawn);
-
-        this->gameLogic();
-
-        if (elapsedTurn >= std::chrono::milliseconds(this->_baseFreqMs))
-            lastUpdate = now;
-
-        if (elapsedRespawn >= respawnInterval) {
-            this->_map.replaceResources();
-            lastResourceRespawn = now;
-        }
+void zappy::game::Game::step()
+{
+    auto tickInterval = this->_tickInterval();
+    auto now = this->_clock.now();
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    this->_profiler.beginIteration();
+    this->gameLogic();
+
+    if (now - this->_lastUpdate >= tickInterval) {
+        TickProfiler::ScopedPhase phase(this->_profiler, TickPhase::FLUSH);
+
+        this->_tickOutput.flush();
+    }
+    while (now - this->_lastUpdate >= tickInterval) {
+        this->_tick += 1;
+        this->_lastUpdate += tickInterval;
+    }
+
+    if (now - this->_lastResourceRespawn >= this->_respawnInterval()) {
+        TickProfiler::ScopedPhase phase(this->_profiler, TickPhase::RESPAWN);
+
+        this->_map.replaceResources();
+        this->_lastResourceRespawn = now;
+    }
+    this->_profiler.endIteration(
+        this->_tick, this->_profiler.getBudget(tickInterval));
+}
+
+void zappy::game::Game::stopGame()
+{
+    this->_serializer.stop();
+    this->_tickOutput.flush();
+    this->_profiler.printSummary(std::cout);
+    if (this->_scheduler.getDeferredLoops() > 0)
+        std::cout << "Command budget: " << this->_scheduler.getDeferredLoops()
+                  << " loops deferred clients to the next time unit" << std::endl;
+    if (this->_snapshotSavePath.empty())
+        return;
+    try {
+        this->saveSnapshot(this->_snapshotSavePath);
+        std::cout << "Snapshot saved to " << this->_snapshotSavePath << std::endl;
+    } catch (const error::SnapshotError &e) {
+        std::cerr << "Snapshot not saved: " << e.what() << std::endl;
     }
 }
+
+zappy::game::GameClock::Clock::time_point zappy::game::Game::getTickTime(
+    uint32_t tick) const
+{
+    uint32_t current = this->_tick;
+
+    if (tick <= current)
+        return this->_lastUpdate;
+    return this->_lastUpdate + this->_tickInterval() * (tick - current);
+}
+
+zappy::game::GameClock::Clock::time_point zappy::game::Game::getNextRuleTime() const
+{
+    auto next = this->_lastResourceRespawn + this->_respawnInterval();
+    auto oldestMeal = this->_players.oldestMeal();
+
+    if (oldestMeal)
+        next = std::min(next, *oldestMeal + this->_mealInterval());
+    return next;
+}
+
+zappy::game::GameClock::Clock::duration zappy::game::Game::_tickInterval() const
+{
+    return std::max(GameClock::Clock::duration(1),
+        std::chrono::duration_cast<GameClock::Clock::duration>(
+            std::chrono::duration<double>(1.0 / this->_baseFreqMs)));
+}
+
+zappy::game::GameClock::Clock::duration zappy::game::Game::_respawnInterval() const
+{
+    return std::chrono::duration_cast<GameClock::Clock::duration>(
+        std::chrono::duration<double>(
+            static_cast<double>(TIME_BEFORE_RESPAWN) / this->_baseFreqMs));
+}
+
+zappy::game::GameClock::Clock::duration zappy::game::Game::_mealInterval() const
+{
+    constexpr int unitLose = 126;
+
+    return std::chrono::duration_cast<GameClock::Clock::duration>(
+        std::chrono::duration<double>(
+            static_cast<double>(unitLose) / this->_baseFreqMs));
+}
@@ -12,10 +12,21 @@
 #include "ServerMap.hpp"
 #include "my_macros.hpp"
 #include "ClientCommand.hpp"
+#include "CommandScheduler.hpp"
+#include "GameClock.hpp"
 #include "GuiCommand.hpp"
+#include "GuiSnapshot.hpp"
+#include "PlayerTable.hpp"
+#include "SerializePool.hpp"
+#include "Snapshot.hpp"
+#include "TickOutput.hpp"
+#include "TickProfiler.hpp"
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace zappy {
     namespace game {
@@ -52,21 +63,33 @@ namespace zappy {
              * @param teamList Vector of teams participating in the game
              * @param freq Reference to the game frequency (time units per second)
              * @param clientNb Maximum number of clients per team
+             * @param seed Seed of the random number generator, the same seed
+             *             and the same input give the same game
+             * @param snapshotPath Snapshot to restore the game from, empty to
+             *                     start a new game
              */
-            Game(int mapWidth, int mapHeight, std::vector<std::shared_ptr<ITeams>> teamList, int &freq, int clientNb)
-                : _commandHandlerGui(freq, mapWidth, mapHeight, clientNb, _map, _teamList),
-                _map(mapWidth, mapHeight, _commandHandlerGui),
-                _commandHandler(freq, _map.getWidth(), _map.getHeight(), clientNb, _map, _teamList),
+            Game(int mapWidth, int mapHeight, std::vector<std::shared_ptr<ITeams>> teamList, int &freq, int clientNb,
+                unsigned int seed, const std::string &snapshotPath = "")
+                : _commandHandlerGui(freq, mapWidth, mapHeight, clientNb, _map, _teamList, _serializer,
+                    _profiler),
+                _map(mapWidth, mapHeight, _commandHandlerGui, seed, snapshotPath.empty()),
+                _commandHandler(freq, _map.getWidth(), _map.getHeight(), clientNb, _map, _teamList,
+                    _serializer, _profiler, _players, _clock),
                 _teamList(teamList),
                 _baseFreqMs(freq),
-                _clientNb(clientNb)
+                _clientNb(clientNb),
+                _random(seed, 1),
+                _guiSnapshot(_map, _teamList, freq, _serializer)
             {
                 for (auto &team : this->_teamList) {
                     auto teamCast = (dynamic_cast<TeamsPlayer*>(&(*team)));
                     if (teamCast)
                         teamCast->setClientNb(_clientNb);
                 }
-                std::srand(std::time(nullptr));
+                if (!snapshotPath.empty()) {
+                    this->_loadSnapshot(snapshotPath);
+                    return;
+                }
                 this->_map.setEggsonMap(teamList, clientNb);
             }
             
@@ -83,6 +106,50 @@ namespace zappy {
              * until the game is stopped or a win condition is met.
              */
             void runGame();
+
+            /**
+             * @brief Prepare the game for step(), called by runGame()
+             */
+            void startGame();
+
+            /**
+             * @brief Run one loop of the game without sleeping
+             * 
+             * Runs the game logic, flushes the output and advances the
+             * tick once a time unit elapsed on the game clock, and respawns
+             * resources when it is time to.
+             */
+            void step();
+
+            /**
+             * @brief Flush the output, print the profile and save the snapshot
+             * 
+             * Called once the game loop stopped, by runGame().
+             */
+            void stopGame();
+
+            /**
+             * @brief Get the game clock
+             * 
+             * @return GameClock& Clock of the command delays, meals and respawn
+             */
+            GameClock &getClock() { return this->_clock; }
+
+            /**
+             * @brief Get the time a tick starts at, at the current frequency
+             * 
+             * @param tick Tick to reach
+             * @return GameClock::Clock::time_point Start of the tick, the
+             * start of the current one for a past tick
+             */
+            GameClock::Clock::time_point getTickTime(uint32_t tick) const;
+
+            /**
+             * @brief Get the next time a meal or a respawn is due
+             * 
+             * @return GameClock::Clock::time_point Earliest of the two
+             */
+            GameClock::Clock::time_point getNextRuleTime() const;
             
             /**
              * @brief Execute core game logic
@@ -109,6 +176,15 @@ namespace zappy {
              * @return RunningState Current state of the game (running, paused, stopped)
              */
             RunningState getRunningState() { return _isRunning; };
+
+            /**
+             * @brief Get the number of time units elapsed since the game started
+             * 
+             * Advances by one every 1 / freq seconds, so it follows sst changes.
+             * 
+             * @return uint32_t Current game tick
+             */
+            uint32_t getTick() const { return this->_tick; }
             
             /**
              * @brief Handle a player's request to join a team
@@ -173,15 +249,13 @@ namespace zappy {
             std::vector<std::shared_ptr<zappy::game::ITeams>> &getTeamList() { return this->_teamList; };
             
             /**
-             * @brief Manage food consumption for a team
-             * 
-             * Handles the food consumption mechanics for all players in a team,
-             * including starvation checks and player death due to lack of food.
-             * This method is called periodically to maintain survival mechanics.
+             * @brief Manage food consumption of every player
              * 
-             * @param team Reference to the team whose food needs to be managed
+             * Scans the meal times of the player table and feeds or kills
+             * only the players whose last meal is old enough. This method
+             * is called on every loop of the game.
              */
-            void foodManager(std::shared_ptr<ITeams> &team);
+            void foodManager();
             
             /**
              * @brief Remove food from a player or handle player death
@@ -191,10 +265,8 @@ namespace zappy {
              * living player to death state.
              * 
              * @param player Reference to the player whose food is being managed
-             * @param itPlayerTeam Reference to the team the player belongs to
              */
-            void removeFoodOrDiedPlayer(std::shared_ptr<zappy::game::ServerPlayer> &player,
-                std::shared_ptr<zappy::game::TeamsPlayer> itPlayerTeam);
+            void removeFoodOrDiedPlayer(std::shared_ptr<zappy::game::ServerPlayer> &player);
             
             /**
              * @brief Get reference to the player command handler
@@ -209,6 +281,62 @@ namespace zappy {
              * @return zappy::game::CommandHandlerGui& Reference to the command handler for GUI clients
              */
             zappy::game::CommandHandlerGui &getCommandHandlerGui() { return _commandHandlerGui; }
+
+            /**
+             * @brief Write the game state to a binary snapshot file
+             * 
+             * Saves map tiles, eggs, teams and players (position, level,
+             * inventory and food timer). See Snapshot.hpp for the layout.
+             * 
+             * @param path Snapshot file path
+             * @throw zappy::error::SnapshotError if the file cannot be written
+             */
+            void saveSnapshot(const std::string &path);
+
+            /**
+             * @brief Set the snapshot written when the game stops
+             * 
+             * @param path Snapshot file path, empty to disable saving
+             */
+            void setSnapshotSavePath(const std::string &path) { this->_snapshotSavePath = path; }
+
+            /**
+             * @brief Set the backend sending the output of joining clients
+             * 
+             * @param sink Backend of the server hosting this game, nullptr
+             * to send from the game thread at the end of each tick
+             */
+            void setOutputSink(zappy::server::IOutputSink *sink) { this->_tickOutput.setNext(sink); }
+
+            /**
+             * @brief Set the time a loop of the game may take
+             * 
+             * A longer loop is logged with its phases and slowest commands,
+             * see TickProfiler.
+             * 
+             * @param budget Maximum duration of a loop, zero for one time unit
+             */
+            void setTickBudget(std::chrono::steady_clock::duration budget) { this->_profiler.setBudget(budget); }
+
+            /**
+             * @brief Set the time the commands of one time unit may take
+             * 
+             * Clients not served once it is spent are served first during
+             * the next time unit, see CommandScheduler.
+             * 
+             * @param budget Time allowed on the game thread, zero for no limit
+             */
+            void setCommandBudget(std::chrono::steady_clock::duration budget) { this->_scheduler.setBudget(budget); }
+
+            /**
+             * @brief Get what a joining GUI must receive
+             * 
+             * Rebuilt only when the game changed since the previous join,
+             * and shared by the GUIs joining in between, see GuiSnapshot.
+             * 
+             * @return std::shared_ptr<const std::string> The serialized world
+             */
+            std::shared_ptr<const std::string> getGuiSnapshot() { return this->_guiSnapshot.get(); }
             
            private:
             /**
@@ -218,6 +346,39 @@ namespace zappy {
              * each player has a unique identifier. Starts at 1.
              */
             int _idPlayerTot = 1;
+
+            /**
+             * @brief Threads rendering the map for mct and joining GUIs
+             *
+             * Declared before the command handlers and the GUI snapshot,
+             * which use it, so that it outlives them.
+             */
+            SerializePool _serializer;
+
+            /**
+             * @brief Time read by the game rules
+             *
+             * Declared before the command handler, which waits on it.
+             */
+            GameClock _clock;
+
+            /**
+             * @brief Start of the current tick, on the game clock
+             */
+            GameClock::Clock::time_point _lastUpdate;
+
+            /**
+             * @brief Last resource respawn, on the game clock
+             */
+            GameClock::Clock::time_point _lastResourceRespawn;
+
+            /**
+             * @brief Time spent in each phase of the loop and each command
+             *
+             * Declared before the command handlers, which record into it.
+             * Its table is printed when runGame() returns.
+             */
+            TickProfiler _profiler;
             
             /**
              * @brief GUI command handler instance
@@ -258,6 +419,24 @@ namespace zappy {
              * dependencies while tracking active players across teams.
              */
             std::vector<std::weak_ptr<zappy::game::Player>> _playerList;
+
+            /**
+             * @brief Hot fields of every AI player, by dense slot
+             * 
+             * Read by the passes over all players: food, Look, Eject,
+             * incantations and broadcasts.
+             */
+            PlayerTable _players;
+
+            /**
+             * @brief Order in which the clients get their commands run
+             */
+            CommandScheduler _scheduler;
+
+            /**
+             * @brief Players selected by the last food pass, reused
+             */
+            std::vector<std::shared_ptr<zappy::game::ServerPlayer>> _hungry;
             
             /**
              * @brief Reference to the base game frequency
@@ -274,6 +453,14 @@ namespace zappy {
              * controlling game balance and server load.
              */
             int _clientNb;
+
+            /**
+             * @brief Generator of the orientation of joining players
+             * 
+             * Seeded from the game seed on its own stream, players only join
+             * from the network thread so it never races the map generator.
+             */
+            Random _random;
             
             /**
              * @brief Atomic game running state
@@ -282,6 +469,81 @@ namespace zappy {
              * of the game (running, paused, stopped). Default is PAUSE.
              */
             std::atomic<RunningState> _isRunning = RunningState::PAUSE;
+
+            /**
+             * @brief World sent to the joining GUIs
+             */
+            GuiSnapshot _guiSnapshot;
+
+            /**
+             * @brief Time units elapsed since runGame() started
+             */
+            std::atomic<uint32_t> _tick = 0;
+
+            /**
+             * @brief Snapshot written when the game loop stops
+             * 
+             * Empty when no snapshot must be saved.
+             */
+            std::string _snapshotSavePath;
+
+            /**
+             * @brief Output of the clients of this game, held until the tick ends
+             * 
+             * Each game has its own: several games can run in one process.
+             */
+            zappy::server::TickOutput _tickOutput;
+
+            /**
+             * @brief Players restored from a snapshot, by team name
+             * 
+             * A client joining one of these teams takes over a restored
+             * player instead of hatching an egg.
+             */
+            std::unordered_map<std::string, std::vector<snapshot::PlayerRecord>> _restoredPlayers;
+
+            /**
+             * @brief Get the duration of a time unit
+             * 
+             * @return GameClock::Clock::duration 1 / freq, at least one clock tick
+             */
+            GameClock::Clock::duration _tickInterval() const;
+
+            /**
+             * @brief Get the time between two resource respawns
+             * 
+             * @return GameClock::Clock::duration TIME_BEFORE_RESPAWN time units
+             */
+            GameClock::Clock::duration _respawnInterval() const;
+
+            /**
+             * @brief Get the time a player lives on one food
+             * 
+             * @return GameClock::Clock::duration 126 time units
+             */
+            GameClock::Clock::duration _mealInterval() const;
+
+            /**
+             * @brief Restore the game state from a binary snapshot file
+             * 
+             * The file is memory-mapped and its sections are read in place.
+             * Teams of the snapshot must all exist in the current game.
+             * 
+             * @param path Snapshot file path
+             * @throw zappy::error::SnapshotError if the file is invalid
+             */
+            void _loadSnapshot(const std::string &path);
+
+            /**
+             * @brief Give a restored player of a team to a joining client
+             * 
+             * @param team Team joined by the client
+             * @param user Client connection object
+             * @return std::shared_ptr<zappy::game::ServerPlayer> The restored player,
+             *         nullptr if the team has no restored player left
+             */
+            std::shared_ptr<zappy::game::ServerPlayer> _takeRestoredPlayer(
+                std::shared_ptr<zappy::game::ITeams> team, zappy::server::Client &user);
             
             /**
              * @brief Check if a client is already in a team
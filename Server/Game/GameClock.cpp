@@ -0,0 +1,109 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** GameClock
+*/
+
+#include "GameClock.hpp"
+
+zappy::game::GameClock::Clock::time_point zappy::game::GameClock::now() const
+{
+    if (!this->_virtual)
+        return Clock::now();
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_now;
+}
+
+void zappy::game::GameClock::setVirtual(Clock::time_point start)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_now = start;
+    this->_virtual = true;
+}
+
+void zappy::game::GameClock::beginWork()
+{
+    if (!this->_virtual)
+        return;
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_busy += 1;
+}
+
+void zappy::game::GameClock::endWork()
+{
+    if (!this->_virtual)
+        return;
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_busy -= 1;
+    if (this->_busy == 0)
+        this->_idle.notify_all();
+}
+
+/**
+ * @brief Block a command thread until a virtual time
+ *
+ * advance() counts every waiting thread as busy again before waking them,
+ * a thread going back to wait stops counting itself, so waitIdle() never
+ * returns between the wake-up and the thread running.
+ */
+bool zappy::game::GameClock::waitUntil(
+    Clock::time_point deadline, const std::function<bool()> &interrupted)
+{
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    auto slot = this->_deadlines.insert(deadline);
+    bool reached = false;
+
+    while (true) {
+        uint64_t generation = this->_generation;
+
+        this->_busy -= 1;
+        if (this->_busy == 0)
+            this->_idle.notify_all();
+        this->_moved.wait(lock, [this, generation]() {
+            return this->_generation != generation;
+        });
+        if (this->_now >= deadline) {
+            reached = true;
+            break;
+        }
+        if (interrupted())
+            break;
+    }
+    this->_deadlines.erase(slot);
+    return reached;
+}
+
+void zappy::game::GameClock::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(this->_mutex);
+
+    this->_idle.wait(lock, [this]() { return this->_busy == 0; });
+}
+
+std::optional<zappy::game::GameClock::Clock::time_point>
+zappy::game::GameClock::nextDeadline() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (this->_deadlines.empty())
+        return std::nullopt;
+    return *this->_deadlines.begin();
+}
+
+void zappy::game::GameClock::advance(Clock::time_point to)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        if (to > this->_now)
+            this->_now = to;
+        this->_generation += 1;
+        this->_busy += this->_deadlines.size();
+    }
+    this->_moved.notify_all();
+}
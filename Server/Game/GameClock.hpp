@@ -0,0 +1,114 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** GameClock
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <set>
+
+namespace zappy {
+    namespace game {
+        /**
+         * @brief Time read by the game rules: command delays, meals, respawn
+         *
+         * A live game reads the steady clock. A replay switches the clock to
+         * virtual time, which only moves when advance() is called: command
+         * threads then block in waitUntil() instead of sleeping, and the
+         * replay jumps straight to the next deadline once every command
+         * thread is blocked or done.
+         *
+         * The command threads are counted as busy from beginWork() to
+         * endWork(), except while they wait, so that waitIdle() tells the
+         * replay when the game cannot move before time does.
+         */
+        class GameClock {
+           public:
+            /** @brief Clock the game time is read from */
+            using Clock = std::chrono::steady_clock;
+
+            /**
+             * @brief Get the current game time
+             *
+             * @return Clock::time_point Steady clock, or the virtual time
+             */
+            Clock::time_point now() const;
+
+            /**
+             * @brief Tell whether the time only moves through advance()
+             *
+             * @return bool True during a replay
+             */
+            bool isVirtual() const { return this->_virtual; }
+
+            /**
+             * @brief Switch to virtual time, before the game starts
+             *
+             * @param start First virtual time
+             */
+            void setVirtual(Clock::time_point start);
+
+            /**
+             * @brief Count a command thread as busy, virtual time only
+             *
+             * Called by the dispatcher before the thread starts, so that
+             * waitIdle() cannot miss it.
+             */
+            void beginWork();
+
+            /**
+             * @brief Stop counting a command thread as busy
+             */
+            void endWork();
+
+            /**
+             * @brief Block a command thread until a virtual time
+             *
+             * @param deadline Time to wait for
+             * @param interrupted Checked each time the time moves, under
+             * the clock lock
+             * @return bool False if interrupted returned true first
+             */
+            bool waitUntil(Clock::time_point deadline, const std::function<bool()> &interrupted);
+
+            /**
+             * @brief Wait until every command thread is blocked or done
+             */
+            void waitIdle();
+
+            /**
+             * @brief Get the earliest time a command thread waits for
+             *
+             * @return std::optional<Clock::time_point> Nothing when no thread waits
+             */
+            std::optional<Clock::time_point> nextDeadline() const;
+
+            /**
+             * @brief Move the virtual time forward and wake the waiting threads
+             *
+             * @param to New virtual time, ignored if not after now()
+             */
+            void advance(Clock::time_point to);
+
+           private:
+            bool _virtual = false;   ///< Set by setVirtual()
+
+            mutable std::mutex _mutex;          ///< Guards every member below
+            std::condition_variable _moved;     ///< Signals advance()
+            std::condition_variable _idle;      ///< Signals _busy reaching 0
+            Clock::time_point _now;             ///< Virtual time
+            uint64_t _generation = 0;           ///< Calls to advance()
+            size_t _busy = 0;                   ///< Command threads running
+            std::multiset<Clock::time_point> _deadlines;  ///< Times waited for
+        };
+    }  // namespace game
+}  // namespace zappy
@@ -0,0 +1,135 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** GuiSnapshot
+*/
+
+#include "GuiSnapshot.hpp"
+#include "MessageFormat.hpp"
+#include "ServerMap.hpp"
+#include "TeamsPlayer.hpp"
+
+std::shared_ptr<const std::string> zappy::game::GuiSnapshot::get()
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    bool changed = true;
+
+    if (this->_snapshot) {
+        changed = this->_renderDirtyTiles();
+    } else {
+        this->_map.trackDirtyTiles();
+        this->_view = this->_map.acquireView();
+        this->_renderAllTiles();
+        this->_view.reset();
+    }
+    this->_nextHead.clear();
+    zappy::server::formatTo(this->_nextHead, "msz ", this->_map.getWidth(),
+        ' ', this->_map.getHeight(), '\n', "sgt ", this->_freq, '\n');
+    this->_renderTail();
+    if (!changed && this->_nextHead == this->_head &&
+        this->_nextTail == this->_tail)
+        return this->_snapshot;
+    this->_head.swap(this->_nextHead);
+    this->_tail.swap(this->_nextTail);
+
+    std::string snapshot;
+    snapshot.reserve(
+        this->_head.size() + this->_tiles.size() + this->_tail.size());
+    snapshot.append(this->_head).append(this->_tiles).append(this->_tail);
+    this->_snapshot = std::make_shared<const std::string>(std::move(snapshot));
+    return this->_snapshot;
+}
+
+void zappy::game::GuiSnapshot::_renderAllTiles()
+{
+    this->_tiles = this->_serializer.renderTiles(this->_view, this->_offsets);
+}
+
+/**
+ * @brief Render again the changed tiles
+ *
+ * The map view is only acquired when a tile changed, after taking the
+ * changed tiles, so it holds every write they report. Unchanged lines are
+ * copied span by span between two changed tiles, and the offsets of each
+ * span are shifted by the size difference so far.
+ */
+bool zappy::game::GuiSnapshot::_renderDirtyTiles()
+{
+    this->_map.takeDirtyTiles(this->_dirty);
+    if (this->_dirty.empty())
+        return false;
+    this->_view = this->_map.acquireView();
+
+    size_t copied = 0;
+    size_t next = 0;
+
+    this->_nextTiles.clear();
+    for (size_t idx : this->_dirty) {
+        size_t end = this->_offsets[idx + 1];
+
+        this->_nextTiles.append(this->_tiles, copied, this->_offsets[idx] - copied);
+        size_t shift = this->_nextTiles.size() - this->_offsets[idx];
+        for (; next <= idx; next += 1)
+            this->_offsets[next] += shift;
+        this->_renderTile(this->_nextTiles, idx);
+        copied = end;
+    }
+    this->_nextTiles.append(this->_tiles, copied, std::string::npos);
+    size_t shift = this->_nextTiles.size() - this->_tiles.size();
+    for (; next < this->_offsets.size(); next += 1)
+        this->_offsets[next] += shift;
+    this->_tiles.swap(this->_nextTiles);
+    this->_view.reset();
+    return true;
+}
+
+void zappy::game::GuiSnapshot::_renderTile(std::string &out, size_t idx)
+{
+    size_t x = idx / this->_map.getHeight();
+    size_t y = idx % this->_map.getHeight();
+    const auto &quantities = this->_view->getResources(x, y);
+
+    zappy::server::formatTo(out, "bct ", x, ' ', y, ' ', quantities[0], ' ',
+        quantities[1], ' ', quantities[2], ' ', quantities[3], ' ',
+        quantities[4], ' ', quantities[5], ' ', quantities[6], '\n');
+}
+
+void zappy::game::GuiSnapshot::_renderTail()
+{
+    std::string &out = this->_nextTail;
+
+    out.clear();
+    for (auto &team : this->_teamList) {
+        if (team->getName() != "GRAPHIC")
+            zappy::server::formatTo(out, "tna ", team->getName(), '\n');
+    }
+    for (auto &team : this->_teamList) {
+        if (!dynamic_cast<TeamsPlayer *>(team.get()))
+            continue;
+        team->forEachPlayer([&out](ServerPlayer &player) {
+            zappy::server::formatTo(out, "pnw #", player.getId(), ' ',
+                player.x, ' ', player.y, ' ',
+                static_cast<int>(player.orientation) + 1, ' ', player.level,
+                ' ', player.teamName, '\n');
+        });
+    }
+    for (auto &team : this->_teamList) {
+        if (team->getName() == "GRAPHIC")
+            continue;
+        team->forEachPlayer([&out](ServerPlayer &player) {
+            const auto &quantities = player.getInventory().getResources();
+
+            zappy::server::formatTo(out, "pin #", player.getId(), ' ',
+                player.x, ' ', player.y, ' ', quantities[0], ' ',
+                quantities[1], ' ', quantities[2], ' ', quantities[3], ' ',
+                quantities[4], ' ', quantities[5], ' ', quantities[6], '\n',
+                "plv #", player.getId(), ' ', player.level, '\n');
+        });
+    }
+    std::lock_guard<std::mutex> lock(this->_map._eggMutex);
+    this->_map.getEggs().forEach([&out](const zappy::game::Egg &egg) {
+        zappy::server::formatTo(
+            out, "enw #", egg.getId(), " -1 ", egg.x, ' ', egg.y, '\n');
+    });
+}
@@ -0,0 +1,174 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** GuiSnapshot
+*/
+
+#pragma once
+
+#include "ITeams.hpp"
+#include "MapView.hpp"
+#include "SerializePool.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace zappy {
+    namespace game {
+        class MapServer;
+
+        /**
+         * @brief Serialized world sent to every GUI when it joins
+         *
+         * Holds, in one buffer, what a joining GUI needs: msz, sgt, one bct
+         * per tile in mct order, tna, pnw for every player, pin and plv for
+         * every player, then enw for every egg.
+         *
+         * The buffer is shared by every GUI joining while the game does not
+         * change, so a join only queues a reference to it. Each join checks
+         * whether a tile changed and renders the players and eggs lines
+         * again; the buffer is rebuilt as soon as either differs, so a GUI
+         * never starts from a state older than its join, even within the
+         * tick that changed it.
+         *
+         * The bct lines are kept between builds: only the tiles the map
+         * reports as changed are rendered again. They are read from a map
+         * view taken after the changed tiles, so no shard lock is held
+         * while rendering.
+         */
+        class GuiSnapshot {
+           public:
+            /**
+             * @brief Constructor for GuiSnapshot
+             *
+             * @param map Map of the game
+             * @param teamList Teams of the game, GUI team included
+             * @param freq Reference to the game frequency
+             * @param serializer Threads rendering the tiles of the first build
+             */
+            GuiSnapshot(MapServer &map,
+                std::vector<std::shared_ptr<ITeams>> &teamList, int &freq,
+                SerializePool &serializer)
+                : _map(map), _teamList(teamList), _freq(freq),
+                  _serializer(serializer) {}
+
+            /**
+             * @brief Get the snapshot of the current game state
+             *
+             * Thread safe. Rebuilds the snapshot if a tile changed or if the
+             * head or the players and eggs lines differ from the held one.
+             *
+             * @return std::shared_ptr<const std::string> The serialized world
+             */
+            std::shared_ptr<const std::string> get();
+
+           private:
+            /**
+             * @brief Map of the game
+             */
+            MapServer &_map;
+
+            /**
+             * @brief Teams of the game
+             */
+            std::vector<std::shared_ptr<ITeams>> &_teamList;
+
+            /**
+             * @brief Reference to the game frequency
+             */
+            int &_freq;
+
+            /**
+             * @brief Threads rendering the tiles of the first build
+             */
+            SerializePool &_serializer;
+
+            /**
+             * @brief Guards every member below
+             */
+            std::mutex _mutex;
+
+            /**
+             * @brief Last snapshot built, nullptr before the first join
+             */
+            std::shared_ptr<const std::string> _snapshot;
+
+            /**
+             * @brief bct lines of every tile, in mct order
+             */
+            std::string _tiles;
+
+            /**
+             * @brief Start of the line of each tile in _tiles, plus the end
+             *
+             * Tile x, y is at index x * height + y.
+             */
+            std::vector<size_t> _offsets;
+
+            /**
+             * @brief Tiles changed since the previous build
+             */
+            std::vector<size_t> _dirty;
+
+            /**
+             * @brief Map view the tiles are read from during a build
+             */
+            std::shared_ptr<const MapView> _view;
+
+            /**
+             * @brief Buffer the next _tiles is built in
+             */
+            std::string _nextTiles;
+
+            /**
+             * @brief msz and sgt lines of the last build
+             */
+            std::string _head;
+
+            /**
+             * @brief tna, players and eggs lines of the last build
+             */
+            std::string _tail;
+
+            /**
+             * @brief Buffer the next _head is rendered in
+             */
+            std::string _nextHead;
+
+            /**
+             * @brief Buffer the next _tail is rendered in
+             */
+            std::string _nextTail;
+
+            /**
+             * @brief Render the bct line of every tile, split between the
+             *        threads of the SerializePool
+             */
+            void _renderAllTiles();
+
+            /**
+             * @brief Render again the bct line of the changed tiles
+             *
+             * @return bool Whether a tile changed since the previous build
+             */
+            bool _renderDirtyTiles();
+
+            /**
+             * @brief Append the bct line of one tile, read from _view
+             *
+             * @param out Buffer receiving the line
+             * @param idx Index x * height + y of the tile
+             */
+            void _renderTile(std::string &out, size_t idx);
+
+            /**
+             * @brief Render the tna, players and eggs lines into _nextTail
+             */
+            void _renderTail();
+        };
+    }  // namespace game
+}  // namespace zappy
@@ -7,30 +7,46 @@
 
 #include "Error.hpp"
 #include "ServerMap.hpp"
+#include "ShardLock.hpp"
+#include <algorithm>
 #include <chrono>
 #include <mutex>
 
 zappy::game::MapServer::MapServer(int width, int height,
-    zappy::game::CommandHandlerGui &commandHandlerGui) :
+    zappy::game::CommandHandlerGui &commandHandlerGui, unsigned int seed,
+    bool placeResources) :
+    _random(seed),
     _commandHandlerGui(commandHandlerGui)
 {
-    std::srand(std::time({}));
-
     this->_width = width;
     this->_height = height;
     this->_init(width, height);
-    this->_placeResources();
+    this->_shardColumns = (width + shardSize - 1) / shardSize;
+    this->_shardRows = (height + shardSize - 1) / shardSize;
+    this->_shardMutexes =
+        std::make_unique<std::mutex[]>(this->getShardCount());
+    this->_dirtyFlags.assign(static_cast<size_t>(width) * height, false);
+    this->_shardStale =
+        std::make_unique<std::atomic<bool>[]>(this->getShardCount());
+    for (size_t idx = 0; idx < this->getShardCount(); idx += 1)
+        this->_shardStale[idx] = true;
+    auto view = std::make_shared<MapView>();
+    view->_width = width;
+    view->_height = height;
+    view->_columns = this->_shardColumns;
+    view->_chunks.resize(this->getShardCount());
+    this->_view = std::move(view);
+    if (placeResources)
+        this->_placeResources();
 }
 
 void zappy::game::MapServer::setEggsonMap(
     std::vector<std::shared_ptr<ITeams>> &teamList, int clientNb)
 {
-    std::srand(std::time(nullptr));
     for (auto &team : teamList) {
         for (int i = 0;  team->getName() != "GRAPHIC" && i < clientNb; i += 1) {
-            size_t x = std::rand() % this->getWidth();
-            size_t y = std::rand() % this->getHeight();
-            zappy::game::Egg newEgg(this->_idEggTot, SERVER_FATHER_ID, x, y);
+            int x = this->_random.below(this->getWidth());
+            int y = this->_random.below(this->getHeight());
             this->addNewEgg(SERVER_FATHER_ID, x, y);
         }
     }
@@ -38,20 +54,107 @@ void zappy::game::MapServer::setEggsonMap(
 
 int zappy::game::MapServer::addNewEgg(int teamId, int x, int y)
 {
-    zappy::game::Egg newEgg(this->_idEggTot, teamId, x, y);
+    this->_eggs.insert(zappy::game::Egg(this->_idEggTot, teamId, x, y));
     this->_idEggTot += 1;
-    this->_eggList.push_back(newEgg);
     return this->_idEggTot - 1;
 }
 
-zappy::game::Egg zappy::game::MapServer::popEgg()
+zappy::game::Egg zappy::game::MapServer::popEgg(int teamId)
 {
-    std::lock_guard<std::mutex> lock(this->_popMutex);
-    if (this->_eggList.empty())
+    auto egg = this->_eggs.pop(teamId);
+
+    if (!egg)
         throw error::EggError("Unable to pop new egg");
-    auto egg = this->_eggList.front();
-    this->_eggList.pop_front();
-    return egg;
+    return *egg;
+}
+
+void zappy::game::MapServer::markTileDirty(size_t x, size_t y)
+{
+    this->_markStale(x, y);
+    if (!this->_trackDirty)
+        return;
+    std::lock_guard<std::mutex> lock(this->_dirtyMutex);
+    this->_markDirty(x, y);
+}
+
+void zappy::game::MapServer::_markDirty(size_t x, size_t y)
+{
+    size_t idx = x * this->_height + y;
+
+    if (this->_dirtyFlags[idx])
+        return;
+    this->_dirtyFlags[idx] = true;
+    this->_dirtyTiles.push_back(idx);
+}
+
+void zappy::game::MapServer::_markStale(size_t x, size_t y)
+{
+    this->_shardStale[this->getShardIndex(x, y)].store(
+        true, std::memory_order_release);
+    this->_viewStale.store(true, std::memory_order_release);
+}
+
+std::shared_ptr<const zappy::game::MapView>
+zappy::game::MapServer::acquireView()
+{
+    std::lock_guard<std::mutex> lock(this->_viewMutex);
+
+    if (!this->_viewStale.exchange(false, std::memory_order_acq_rel))
+        return this->_view;
+    auto view = std::make_shared<MapView>(*this->_view);
+
+    view->_epoch += 1;
+    for (size_t idx = 0; idx < this->getShardCount(); idx += 1) {
+        if (this->_shardStale[idx].exchange(false, std::memory_order_acq_rel))
+            view->_chunks[idx] = this->_copyShard(idx);
+    }
+    this->_view = std::move(view);
+    return this->_view;
+}
+
+std::shared_ptr<const zappy::game::TileChunk>
+zappy::game::MapServer::_copyShard(size_t idx)
+{
+    auto chunk = std::make_shared<TileChunk>();
+    size_t startX = (idx % this->_shardColumns) * shardSize;
+    size_t startY = (idx / this->_shardColumns) * shardSize;
+    size_t endX = std::min(startX + shardSize, this->_width);
+    size_t endY = std::min(startY + shardSize, this->_height);
+    std::lock_guard<std::mutex> lock(this->_shardMutexes[idx]);
+
+    for (size_t x = startX; x < endX; x += 1) {
+        for (size_t y = startY; y < endY; y += 1)
+            chunk->tiles[(x - startX) * shardSize + y - startY] =
+                this->getTile(x, y).getResources();
+    }
+    return chunk;
+}
+
+void zappy::game::MapServer::takeDirtyTiles(std::vector<size_t> &tiles)
+{
+    std::lock_guard<std::mutex> lock(this->_dirtyMutex);
+
+    tiles.swap(this->_dirtyTiles);
+    this->_dirtyTiles.clear();
+    for (size_t idx : tiles)
+        this->_dirtyFlags[idx] = false;
+    std::sort(tiles.begin(), tiles.end());
+}
+
+void zappy::game::MapServer::_scatterResource(int resourceIdx, size_t count)
+{
+    this->_random.fillCoordinates(count, this->_width, this->_height,
+        this->_placement);
+    for (auto &coordinates : this->_placement) {
+        this->getTile(coordinates.x, coordinates.y)
+            .addResource(static_cast<zappy::game::Resource>(resourceIdx), 1);
+        this->_markStale(coordinates.x, coordinates.y);
+    }
+    if (!this->_trackDirty)
+        return;
+    std::lock_guard<std::mutex> lock(this->_dirtyMutex);
+    for (auto &coordinates : this->_placement)
+        this->_markDirty(coordinates.x, coordinates.y);
 }
 
 void zappy::game::MapServer::_placeResources()
@@ -59,43 +162,30 @@ void zappy::game::MapServer::_placeResources()
     size_t nbResources = zappy::game::coeff.size();
     auto mapWidth = this->_width;
     auto mapHeight = this->_height;
+    zappy::game::ShardLock lock(*this);
 
-    std::lock_guard<std::mutex> lock(this->_resourceMutex);
+    lock.addAll();
+    lock.lock();
     for (size_t resourceIdx = 0; resourceIdx < nbResources; resourceIdx += 1) {
         int totalResources = coeff[resourceIdx] * mapWidth * mapHeight;
 
-        for (int resourceCount = 0; resourceCount < totalResources;
-            resourceCount += 1) {
-            int randX = std::rand() % mapWidth;
-            int randY = std::rand() % mapHeight;
-
-            zappy::game::Tile &tile = this->getTile(randX, randY);
-            tile.addResource(
-                static_cast<zappy::game::Resource>(resourceIdx), 1);
-        }
+        if (totalResources > 0)
+            this->_scatterResource(resourceIdx, totalResources);
     }
 }
 
-void zappy::game::MapServer::addReplaceResourceOnTile(int resourceIdx)
-{
-    int randX = std::rand() % this->_width;
-    int randY = std::rand() % this->_height;
-    zappy::game::Tile &tile = this->getTile(randX, randY);
-    tile.addResource(
-        static_cast<zappy::game::Resource>(resourceIdx), 1);
-}
-
 void zappy::game::MapServer::replaceResources()
 {
     size_t nbResources = zappy::game::coeff.size();
+    zappy::game::ShardLock lock(*this);
 
-    std::lock_guard<std::mutex> lock(this->_resourceMutex);
+    lock.addAll();
+    lock.lock();
     for (size_t resourceIdx = 0; resourceIdx < nbResources; resourceIdx += 1) {
         int totResources = coeff[resourceIdx] * this->_width * this->_height;
         int actualResources =
             this->getResourceQuantity(static_cast<zappy::game::Resource>(resourceIdx));
-        for (int count = actualResources; count < totResources; count += 1) {
-            addReplaceResourceOnTile(resourceIdx);
-        }
+        if (actualResources < totResources)
+            this->_scatterResource(resourceIdx, totResources - actualResources);
     }
 }
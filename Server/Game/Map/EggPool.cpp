@@ -0,0 +1,63 @@
+//
+// EPITECH PROJECT, 2025
+// EggPool
+// File description:
+// Eggs waiting to hatch, indexed per team
+//
+
+#include "EggPool.hpp"
+
+void zappy::game::EggPool::insert(const Egg &egg)
+{
+    size_t idx = this->_freeHead;
+    List &list = this->_pools[egg.getFatherId()];
+
+    if (idx == npos) {
+        idx = this->_slots.size();
+        this->_slots.push_back({egg, egg.getFatherId(), npos, npos, true});
+    } else {
+        this->_freeHead = this->_slots[idx].next;
+        this->_slots[idx] = {egg, egg.getFatherId(), npos, npos, true};
+    }
+
+    Slot &slot = this->_slots[idx];
+    slot.prev = list.tail;
+    if (list.tail != npos)
+        this->_slots[list.tail].next = idx;
+    else
+        list.head = idx;
+    list.tail = idx;
+    this->_size += 1;
+}
+
+std::optional<zappy::game::Egg> zappy::game::EggPool::pop(int teamId)
+{
+    for (int poolId : {teamId, sharedPool}) {
+        auto list = this->_pools.find(poolId);
+
+        if (list != this->_pools.end() && list->second.head != npos)
+            return this->_release(list->second.head);
+    }
+    return std::nullopt;
+}
+
+zappy::game::Egg zappy::game::EggPool::_release(size_t idx)
+{
+    Slot &slot = this->_slots[idx];
+    List &list = this->_pools[slot.pool];
+
+    if (slot.prev != npos)
+        this->_slots[slot.prev].next = slot.next;
+    else
+        list.head = slot.next;
+    if (slot.next != npos)
+        this->_slots[slot.next].prev = slot.prev;
+    else
+        list.tail = slot.prev;
+
+    this->_size -= 1;
+    slot.used = false;
+    slot.next = this->_freeHead;
+    this->_freeHead = idx;
+    return slot.egg;
+}
@@ -0,0 +1,119 @@
+//
+// EPITECH PROJECT, 2025
+// EggPool
+// File description:
+// Eggs waiting to hatch, indexed per team
+//
+
+#pragma once
+
+#include "Egg.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace zappy {
+    namespace game {
+
+        /**
+         * @brief Eggs waiting to hatch, indexed per team
+         *
+         * Eggs live in one contiguous array of slots. Each team has its own
+         * FIFO list threaded through the slots, the eggs laid by the server
+         * at startup go to the shared pool, and freed slots are kept in a
+         * free list for the next egg. Insertion and hatching are O(1). The
+         * pool is not thread-safe, MapServer guards it with its egg mutex.
+         */
+        class EggPool {
+           public:
+            /**
+             * @brief Pool of the eggs laid by the server itself
+             *
+             * Any team can hatch from it once its own eggs are gone.
+             */
+            static constexpr int sharedPool = -1;
+
+            /**
+             * @brief Add an egg to the pool of its team
+             *
+             * The pool is the egg father id: the id of the team that forked
+             * it, or sharedPool for the eggs placed by the server.
+             *
+             * @param egg Egg to add, its id must not be in the pool yet
+             */
+            void insert(const Egg &egg);
+
+            /**
+             * @brief Take the oldest egg a team can hatch from
+             *
+             * Eggs of the team come first, then the shared pool.
+             *
+             * @param teamId Id of the joining team
+             * @return std::optional<Egg> The egg, empty when none is left
+             */
+            std::optional<Egg> pop(int teamId);
+
+            /**
+             * @brief Get the number of eggs in the pool
+             *
+             * @return size_t Number of eggs
+             */
+            size_t size() const { return this->_size; }
+
+            /**
+             * @brief Call a function on every egg of the pool
+             *
+             * @param func Function taking a const Egg &
+             */
+            template <typename Func>
+            void forEach(Func &&func) const
+            {
+                for (const auto &slot : this->_slots) {
+                    if (slot.used)
+                        func(slot.egg);
+                }
+            }
+
+           private:
+            /// Marks the end of a list of slots
+            static constexpr size_t npos = SIZE_MAX;
+
+            /**
+             * @brief One cell of the egg array
+             *
+             * prev and next link the slot in its team list when used, next
+             * links it in the free list otherwise.
+             */
+            struct Slot {
+                Egg egg;
+                int pool;
+                size_t prev;
+                size_t next;
+                bool used;
+            };
+
+            /**
+             * @brief Ends of the list of a team
+             */
+            struct List {
+                size_t head = npos;
+                size_t tail = npos;
+            };
+
+            /**
+             * @brief Unlink a used slot from its team list and free it
+             *
+             * @param idx Index of the slot
+             * @return Egg The egg the slot held
+             */
+            Egg _release(size_t idx);
+
+            std::vector<Slot> _slots;                     ///< Egg storage
+            size_t _freeHead = npos;                      ///< First free slot
+            std::unordered_map<int, List> _pools;         ///< Team id to egg list
+            size_t _size = 0;                             ///< Used slots
+        };
+    }  // namespace game
+}  // namespace zappy
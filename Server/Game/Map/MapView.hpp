@@ -0,0 +1,95 @@
+//
+// EPITECH PROJECT, 2025
+// Map
+// File description:
+// Immutable view of the map resources
+//
+
+#pragma once
+
+#include "Resource.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace zappy {
+    namespace game {
+        /**
+         * @brief Copy of the resources of one map shard
+         *
+         * Never modified once published: a write to the shard makes the
+         * next publication copy the shard again into a new chunk.
+         */
+        struct TileChunk {
+            /** @brief Side length of a chunk, equal to MapServer::shardSize */
+            static constexpr size_t side = 8;
+
+            /** @brief Resources of each tile, by (x % side) * side + y % side */
+            std::array<std::array<size_t, RESOURCE_QUANTITY>, side * side> tiles{};
+        };
+
+        /**
+         * @brief Consistent, read-only view of the map resources
+         *
+         * Published by MapServer::acquireView(). Each chunk was copied under
+         * the lock of its shard, and a view never changes once published,
+         * so it can be read from any thread without lock while the game
+         * goes on. Two views share the chunks of the shards that did not
+         * change between them.
+         */
+        class MapView {
+           public:
+            /**
+             * @brief Get the publication number of the view
+             *
+             * @return uint64_t Number incremented by every publication
+             */
+            uint64_t getEpoch() const { return this->_epoch; }
+
+            /**
+             * @brief Get the width of the map
+             *
+             * @return size_t Width in tiles
+             */
+            size_t getWidth() const { return this->_width; }
+
+            /**
+             * @brief Get the height of the map
+             *
+             * @return size_t Height in tiles
+             */
+            size_t getHeight() const { return this->_height; }
+
+            /**
+             * @brief Get the resources of a tile
+             *
+             * @param x X coordinate of the tile
+             * @param y Y coordinate of the tile
+             * @return const std::array<size_t, RESOURCE_QUANTITY>& Quantity of each resource
+             */
+            const std::array<size_t, RESOURCE_QUANTITY> &getResources(
+                size_t x, size_t y) const
+            {
+                const TileChunk &chunk = *this->_chunks[
+                    (y / TileChunk::side) * this->_columns + x / TileChunk::side];
+
+                return chunk.tiles[(x % TileChunk::side) * TileChunk::side +
+                    y % TileChunk::side];
+            }
+
+           private:
+            friend class MapServer;
+
+            uint64_t _epoch = 0;   ///< Publication number
+            size_t _width = 0;     ///< Width of the map
+            size_t _height = 0;    ///< Height of the map
+            size_t _columns = 0;   ///< Number of chunks along the X axis
+
+            /** @brief One chunk per shard, indexed by MapServer::getShardIndex() */
+            std::vector<std::shared_ptr<const TileChunk>> _chunks;
+        };
+    }  // namespace game
+}  // namespace zappy
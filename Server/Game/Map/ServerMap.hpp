@@ -8,12 +8,17 @@
 #pragma once
 
 #include "Egg.hpp"
+#include "EggPool.hpp"
 #include "Map.hpp"
+#include "MapView.hpp"
 #include "ITeams.hpp"
+#include "Random.hpp"
+#include <atomic>
 #include <exception>
 #include <sstream>
-#include <list>
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include "TeamsGui.hpp"
 #include "GuiCommand.hpp"
 
@@ -44,8 +49,13 @@ namespace zappy {
              * @param mapWidth Width of the game map
              * @param mapHeight Height of the game map
              * @param commandHandlerGui Reference to the GUI command handler for client communication
+             * @param seed Seed of the random placement, the same seed gives the same map
+             * @param placeResources Whether to randomly fill the map, false when
+             *                       its content comes from a snapshot
              */
-            explicit MapServer(int mapWidth, int mapHeight, zappy::game::CommandHandlerGui &commandHandlerGui);
+            explicit MapServer(int mapWidth, int mapHeight,
+                zappy::game::CommandHandlerGui &commandHandlerGui,
+                unsigned int seed, bool placeResources = true);
             
             /**
              * @brief Default destructor
@@ -69,23 +79,37 @@ namespace zappy {
              * 
              * Creates a new egg for a specific team at given coordinates.
              * The egg will be available for players of that team to hatch from.
+             * The caller must hold _eggMutex.
              * 
-             * @param teamId ID of the team the egg belongs to
+             * @param teamId ID of the team the egg belongs to, SERVER_FATHER_ID
+             *               for the shared pool
              * @param x X coordinate where the egg is placed
              * @param y Y coordinate where the egg is placed
              * @return int The unique ID of the newly created egg
              */
             int addNewEgg(int teamId, int x, int y);
+
+            /**
+             * @brief Put back an egg that already has an id
+             *
+             * Used when restoring a snapshot. The caller must hold _eggMutex.
+             *
+             * @param egg Egg to put back on the map
+             */
+            void restoreEgg(const zappy::game::Egg &egg) { this->_eggs.insert(egg); }
             
             /**
-             * @brief Remove and return an egg from the map
+             * @brief Remove and return an egg a team can hatch from
              * 
-             * Pops an egg from the egg list, typically when a player connects
-             * and hatches from an egg. This operation is thread-safe.
+             * Takes the oldest egg of the team, or of the shared pool when the
+             * team has none left, typically when a player connects. The caller
+             * must hold _eggMutex.
              * 
+             * @param teamId ID of the joining team
              * @return zappy::game::Egg The egg that was removed from the map
+             * @throw error::EggError if no egg is left for the team
              */
-            zappy::game::Egg popEgg();
+            zappy::game::Egg popEgg(int teamId);
             
             /**
              * @brief Replace resources on the map
@@ -97,24 +121,30 @@ namespace zappy {
             void replaceResources();
             
             /**
-             * @brief Add a replacement resource to a random tile
-             * 
-             * Adds a specific type of resource to a randomly selected tile on the map.
-             * This is used by the resource replacement system to maintain resource
-             * distribution across the game world.
-             * 
-             * @param resourceIdx Index of the resource type to add (0-6):
-             *                   0=food, 1=linemate, 2=deraumere, 3=sibur,
-             *                   4=mendiane, 5=phiras, 6=thystame
+             * @brief Get the eggs waiting on the map
+             *
+             * The caller must hold _eggMutex while using it.
+             *
+             * @return const EggPool& Eggs of every team
              */
-            void addReplaceResourceOnTile(int resourceIdx);
-            
+            const EggPool &getEggs() const { return this->_eggs; }
+
             /**
-             * @brief Get reference to the egg list
-             * 
-             * @return std::list<Egg>& Reference to the list of eggs on the map
+             * @brief Get the id the next egg will receive
+             *
+             * @return int Next egg id
+             */
+            int getNextEggId() const { return this->_idEggTot; }
+
+            /**
+             * @brief Set the id the next egg will receive
+             *
+             * Used when restoring a snapshot so that new eggs do not reuse
+             * the id of a restored one.
+             *
+             * @param id Next egg id
              */
-            std::list<Egg> &getEggList() { return _eggList; }
+            void setNextEggId(int id) { this->_idEggTot = id; }
             
             /**
              * @brief Timestamp of the last resource respawn
@@ -125,28 +155,111 @@ namespace zappy {
             std::chrono::steady_clock::time_point _lastResourceRespawn = std::chrono::steady_clock::now();
             
             /**
-             * @brief Mutex for thread-safe resource operations
-             * 
-             * Protects resource-related operations from race conditions
-             * in multi-threaded server environment.
+             * @brief Side length, in tiles, of a map shard
+             *
+             * The map is split into square blocks of tiles, each guarded by
+             * its own mutex, so commands on distant tiles run in parallel.
              */
-            std::mutex _resourceMutex;
-            
+            static constexpr size_t shardSize = 8;
+            static_assert(shardSize == TileChunk::side,
+                "a view chunk must cover exactly one shard");
+
             /**
-             * @brief Mutex for thread-safe egg operations
-             * 
-             * Protects egg list operations from race conditions
-             * when multiple threads access or modify eggs.
+             * @brief Get the index of the shard owning a tile
+             *
+             * @param x X coordinate of the tile
+             * @param y Y coordinate of the tile
+             * @return size_t Index of the shard, in [0, getShardCount())
              */
-            std::mutex _eggMutex;
-            
+            size_t getShardIndex(size_t x, size_t y) const
+            {
+                return (y / shardSize) * this->_shardColumns + x / shardSize;
+            }
+
+            /**
+             * @brief Get the number of shards of the map
+             *
+             * @return size_t Number of shards
+             */
+            size_t getShardCount() const
+            {
+                return this->_shardColumns * this->_shardRows;
+            }
+
+            /**
+             * @brief Get the mutex guarding a shard
+             *
+             * Locking several shards must go through ShardLock so that they
+             * are always taken in the same order.
+             *
+             * @param idx Index of the shard
+             * @return std::mutex& Mutex of the shard
+             */
+            std::mutex &getShardMutex(size_t idx) { return this->_shardMutexes[idx]; }
+
+            /**
+             * @brief Get the mutex of the shard owning a tile
+             *
+             * Enough for commands that only touch a single tile.
+             *
+             * @param x X coordinate of the tile
+             * @param y Y coordinate of the tile
+             * @return std::mutex& Mutex of the owning shard
+             */
+            std::mutex &getTileMutex(size_t x, size_t y)
+            {
+                return this->_shardMutexes[this->getShardIndex(x, y)];
+            }
+
+            /**
+             * @brief Start recording the tiles whose resources change
+             *
+             * Called before the first GUI snapshot is built, a server
+             * without GUI never pays for the tracking.
+             */
+            void trackDirtyTiles() { this->_trackDirty = true; }
+
+            /**
+             * @brief Record that the resources of a tile changed
+             *
+             * The caller holds the mutex of the tile shard.
+             *
+             * @param x X coordinate of the tile
+             * @param y Y coordinate of the tile
+             */
+            void markTileDirty(size_t x, size_t y);
+
+            /**
+             * @brief Get a view of the current map resources
+             *
+             * Thread safe. Publishes a new view first if a tile changed
+             * since the last one: only the changed shards are copied, each
+             * under its own lock, the other chunks are shared with the
+             * previous view. A view never reflects half of a write, and
+             * every write that completed before the call is in it.
+             *
+             * Must not be called while holding a shard mutex.
+             *
+             * @return std::shared_ptr<const MapView> The view, readable
+             *         without any lock
+             */
+            std::shared_ptr<const MapView> acquireView();
+
+            /**
+             * @brief Take the tiles changed since the previous call
+             *
+             * @param tiles Receives the index x * height + y of every
+             *              changed tile, in increasing order
+             */
+            void takeDirtyTiles(std::vector<size_t> &tiles);
+
             /**
-             * @brief Mutex for thread-safe egg popping operations
+             * @brief Mutex for thread-safe egg operations
              * 
-             * Protects the egg popping mechanism from race conditions
-             * when multiple players try to connect simultaneously.
+             * The only lock of the egg pool: joins, forks, GUI bootstrap and
+             * snapshots all take it around their egg operations.
              */
-            std::mutex _popMutex;
+            std::mutex _eggMutex;
             
            private:
             /**
@@ -156,7 +269,94 @@ namespace zappy {
              * each egg has a unique identifier. Starts at 2.
              */
             int _idEggTot = 2;
+
+            /**
+             * @brief Number of shards along the X axis
+             */
+            size_t _shardColumns = 0;
+
+            /**
+             * @brief Number of shards along the Y axis
+             */
+            size_t _shardRows = 0;
+
+            /**
+             * @brief One mutex per shard, indexed by getShardIndex()
+             *
+             * Guards the resources of the shard tiles and the positions of
+             * the players standing on them.
+             */
+            std::unique_ptr<std::mutex[]> _shardMutexes;
             
+            /**
+             * @brief Whether markTileDirty() records anything
+             */
+            std::atomic<bool> _trackDirty = false;
+
+            /**
+             * @brief Guards _dirtyTiles and _dirtyFlags
+             */
+            std::mutex _dirtyMutex;
+
+            /**
+             * @brief Tiles changed since the last takeDirtyTiles(), unsorted
+             */
+            std::vector<size_t> _dirtyTiles;
+
+            /**
+             * @brief One flag per tile, set while it is in _dirtyTiles
+             */
+            std::vector<bool> _dirtyFlags;
+
+            /**
+             * @brief One flag per shard, set when one of its tiles changed
+             *        since the shard was last copied into a view
+             */
+            std::unique_ptr<std::atomic<bool>[]> _shardStale;
+
+            /**
+             * @brief Whether any shard flag may be set
+             */
+            std::atomic<bool> _viewStale = true;
+
+            /**
+             * @brief Guards _view and serializes the publications
+             */
+            std::mutex _viewMutex;
+
+            /**
+             * @brief Last published view
+             */
+            std::shared_ptr<const MapView> _view;
+
+            /**
+             * @brief Record that a tile must be copied again in the next view
+             *
+             * The caller holds the mutex of the tile shard, after changing it.
+             *
+             * @param x X coordinate of the tile
+             * @param y Y coordinate of the tile
+             */
+            void _markStale(size_t x, size_t y);
+
+            /**
+             * @brief Copy the resources of a shard into a new chunk
+             *
+             * Takes the mutex of the shard.
+             *
+             * @param idx Index of the shard
+             * @return std::shared_ptr<const TileChunk> The new chunk
+             */
+            std::shared_ptr<const TileChunk> _copyShard(size_t idx);
+
+            /**
+             * @brief Record a changed tile, the caller holds _dirtyMutex
+             *
+             * @param x X coordinate of the tile
+             * @param y Y coordinate of the tile
+             */
+            void _markDirty(size_t x, size_t y);
+
             /**
              * @brief Place initial resources on the map
              * 
@@ -164,14 +364,38 @@ namespace zappy {
              * all tiles when the map is first created.
              */
             void _placeResources();
+
+            /**
+             * @brief Add units of a resource on random tiles
+             * 
+             * Draws all the coordinates in one batch before touching the
+             * tiles. The caller must hold the lock of every shard.
+             * 
+             * @param resourceIdx Index of the resource to add
+             * @param count Number of units to add
+             */
+            void _scatterResource(int resourceIdx, size_t count);
             
             /**
-             * @brief List of eggs currently on the map
+             * @brief Eggs currently on the map
+             * 
+             * Maintains all eggs that are available for players to hatch from,
+             * indexed by the team that laid them.
+             */
+            EggPool _eggs;
+
+            /**
+             * @brief Generator of every random placement on the map
              * 
-             * Maintains all eggs that are available for players to hatch from.
-             * Each egg belongs to a specific team and has a unique position.
+             * Only used while all the shards are locked or before the game
+             * starts, so it is never drawn from two threads at once.
+             */
+            Random _random;
+
+            /**
+             * @brief Coordinates buffer reused by _scatterResource
              */
-            std::list<Egg> _eggList;
+            std::vector<Coordinates> _placement;
             
             /**
              * @brief Reference to the GUI command handler
@@ -0,0 +1,100 @@
+//
+// EPITECH PROJECT, 2025
+// Map
+// File description:
+// Ordered lock over several map shards
+//
+
+#pragma once
+
+#include "ServerMap.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace zappy {
+    namespace game {
+        /**
+         * @brief Lock over the map shards touched by one command
+         *
+         * Commands that touch several tiles use two phases: first every
+         * tile is registered with addTile(), then lock() takes the owning
+         * shards once each, in ascending index order. Since every command
+         * locks in the same order, two commands working on overlapping
+         * regions can never deadlock, and commands on distant regions never
+         * wait on each other. Shards are released when the lock is destroyed.
+         */
+        class ShardLock {
+           public:
+            /**
+             * @brief Create an empty lock on a map
+             *
+             * @param map Map owning the shards
+             */
+            explicit ShardLock(MapServer &map) : _map(map)
+            {
+                this->_shards.reserve(maxReservedShards);
+            }
+
+            ShardLock(const ShardLock &) = delete;
+            ShardLock &operator=(const ShardLock &) = delete;
+
+            /**
+             * @brief Release every locked shard
+             */
+            ~ShardLock()
+            {
+                if (!this->_locked)
+                    return;
+                for (auto it = this->_shards.rbegin(); it != this->_shards.rend();
+                    ++it)
+                    this->_map.getShardMutex(*it).unlock();
+            }
+
+            /**
+             * @brief Register a tile whose shard must be locked
+             *
+             * @param x X coordinate of the tile
+             * @param y Y coordinate of the tile
+             */
+            void addTile(size_t x, size_t y)
+            {
+                size_t shard = this->_map.getShardIndex(x, y);
+
+                if (std::find(this->_shards.begin(), this->_shards.end(),
+                        shard) == this->_shards.end())
+                    this->_shards.push_back(shard);
+            }
+
+            /**
+             * @brief Register every shard of the map
+             */
+            void addAll()
+            {
+                this->_shards.clear();
+                for (size_t idx = 0; idx < this->_map.getShardCount(); idx += 1)
+                    this->_shards.push_back(idx);
+            }
+
+            /**
+             * @brief Lock the registered shards in ascending order
+             */
+            void lock()
+            {
+                std::sort(this->_shards.begin(), this->_shards.end());
+                for (size_t idx : this->_shards)
+                    this->_map.getShardMutex(idx).lock();
+                this->_locked = true;
+            }
+
+           private:
+            /** @brief Shards covered by a level 8 look cone, in the worst case */
+            static constexpr size_t maxReservedShards = 16;
+
+            MapServer &_map;             /**< Map owning the shards */
+            std::vector<size_t> _shards; /**< Registered shard indexes */
+            bool _locked = false;        /**< Whether lock() was called */
+        };
+    }  // namespace game
+}  // namespace zappy
@@ -0,0 +1,152 @@
+//
+// EPITECH PROJECT, 2025
+// PlayerTable
+// File description:
+// Dense table of the hot fields of every player
+//
+
+#include "PlayerTable.hpp"
+
+#include <algorithm>
+
+void zappy::game::PlayerTable::add(
+    std::shared_ptr<ServerPlayer> player, Clock::time_point lastMeal)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    size_t slot = this->_players.size();
+
+    this->_x.push_back(0);
+    this->_y.push_back(0);
+    this->_orientation.push_back(0);
+    this->_level.push_back(0);
+    this->_lastMeal.push_back(lastMeal.time_since_epoch().count());
+    this->_store(slot, *player);
+    player->slot = slot;
+    this->_players.push_back(std::move(player));
+}
+
+void zappy::game::PlayerTable::remove(ServerPlayer &player)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    size_t slot = player.slot;
+
+    if (slot >= this->_players.size() || this->_players[slot].get() != &player)
+        return;
+    size_t last = this->_players.size() - 1;
+
+    if (slot != last) {
+        this->_x[slot] = this->_x[last];
+        this->_y[slot] = this->_y[last];
+        this->_orientation[slot] = this->_orientation[last];
+        this->_level[slot] = this->_level[last];
+        this->_lastMeal[slot] = this->_lastMeal[last];
+        this->_players[slot] = std::move(this->_players[last]);
+        this->_players[slot]->slot = slot;
+    }
+    this->_x.pop_back();
+    this->_y.pop_back();
+    this->_orientation.pop_back();
+    this->_level.pop_back();
+    this->_lastMeal.pop_back();
+    this->_players.pop_back();
+    player.slot = noSlot;
+}
+
+void zappy::game::PlayerTable::sync(const ServerPlayer &player)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (player.slot < this->_players.size())
+        this->_store(player.slot, player);
+}
+
+void zappy::game::PlayerTable::feed(const ServerPlayer &player, Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (player.slot < this->_players.size())
+        this->_lastMeal[player.slot] = now.time_since_epoch().count();
+}
+
+zappy::game::PlayerTable::Clock::duration zappy::game::PlayerTable::sinceMeal(
+    const ServerPlayer &player, Clock::time_point now) const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (player.slot >= this->_players.size())
+        return Clock::duration::zero();
+    return now - Clock::time_point(Clock::duration(this->_lastMeal[player.slot]));
+}
+
+void zappy::game::PlayerTable::collectHungry(Clock::time_point threshold,
+    std::vector<std::shared_ptr<ServerPlayer>> &out) const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    Clock::rep limit = threshold.time_since_epoch().count();
+    const Clock::rep *lastMeal = this->_lastMeal.data();
+
+    for (size_t slot = 0; slot < this->_lastMeal.size(); slot += 1) {
+        if (lastMeal[slot] <= limit)
+            out.push_back(this->_players[slot]);
+    }
+}
+
+std::optional<zappy::game::PlayerTable::Clock::time_point>
+zappy::game::PlayerTable::oldestMeal() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (this->_lastMeal.empty())
+        return std::nullopt;
+    return Clock::time_point(Clock::duration(
+        *std::min_element(this->_lastMeal.begin(), this->_lastMeal.end())));
+}
+
+/**
+ * @brief Count the players standing on a tile
+ *
+ * Branch-free over the coordinate arrays so that the compiler turns the
+ * loop into vector compares, Look calls it for every visible tile.
+ */
+size_t zappy::game::PlayerTable::countOnTile(size_t x, size_t y) const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    const uint32_t *xs = this->_x.data();
+    const uint32_t *ys = this->_y.data();
+    uint32_t tileX = static_cast<uint32_t>(x);
+    uint32_t tileY = static_cast<uint32_t>(y);
+    size_t count = 0;
+
+    for (size_t slot = 0; slot < this->_x.size(); slot += 1)
+        count += static_cast<size_t>((xs[slot] == tileX) & (ys[slot] == tileY));
+    return count;
+}
+
+std::vector<std::weak_ptr<zappy::game::ServerPlayer>>
+zappy::game::PlayerTable::playersOnTile(size_t x, size_t y, size_t level) const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    std::vector<std::weak_ptr<ServerPlayer>> players;
+
+    for (size_t slot = 0; slot < this->_x.size(); slot += 1) {
+        if (this->_x[slot] == x && this->_y[slot] == y &&
+            (level == 0 || this->_level[slot] == level))
+            players.push_back(this->_players[slot]);
+    }
+    return players;
+}
+
+size_t zappy::game::PlayerTable::size() const
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    return this->_players.size();
+}
+
+void zappy::game::PlayerTable::_store(size_t slot, const ServerPlayer &player)
+{
+    this->_x[slot] = static_cast<uint32_t>(player.x);
+    this->_y[slot] = static_cast<uint32_t>(player.y);
+    this->_orientation[slot] = static_cast<uint8_t>(player.orientation);
+    this->_level[slot] = static_cast<uint8_t>(player.level);
+}
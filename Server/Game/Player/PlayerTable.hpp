@@ -0,0 +1,171 @@
+//
+// EPITECH PROJECT, 2025
+// PlayerTable
+// File description:
+// Dense table of the hot fields of every player
+//
+
+#pragma once
+
+#include "ServerPlayer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace zappy {
+    namespace game {
+        /**
+         * @brief Players of a game, stored as parallel arrays
+         *
+         * Every AI player owns one slot while it is alive. The fields read
+         * by the passes over all players (position, orientation, level and
+         * time of the last meal) are kept in one array each, so that those
+         * passes stream through contiguous memory instead of following a
+         * shared_ptr per player. The ServerPlayer stays the cold part: its
+         * client, inventory, team and name are only reached for the players
+         * a pass selects.
+         *
+         * Slots are dense: removing a player moves the last one into its
+         * slot. Position, orientation and level are copies, sync() must be
+         * called after changing them on the ServerPlayer. The time of the
+         * last meal only lives here.
+         *
+         * Every method takes the table lock, which is never held while
+         * taking another lock, except the output lock of a client in
+         * forEachPlayer() callbacks.
+         */
+        class PlayerTable {
+           public:
+            /** @brief Clock of the meal times */
+            using Clock = std::chrono::steady_clock;
+
+            /** @brief Slot of a player outside any table */
+            static constexpr size_t noSlot = ServerPlayer::noSlot;
+
+            /**
+             * @brief Give a slot to a player
+             *
+             * @param player Player to add, kept alive while in the table
+             * @param lastMeal Time of its last meal
+             */
+            void add(std::shared_ptr<ServerPlayer> player, Clock::time_point lastMeal);
+
+            /**
+             * @brief Free the slot of a player
+             *
+             * Does nothing if the player has no slot.
+             *
+             * @param player Player to remove
+             */
+            void remove(ServerPlayer &player);
+
+            /**
+             * @brief Copy the position, orientation and level of a player
+             *
+             * @param player Player whose fields changed
+             */
+            void sync(const ServerPlayer &player);
+
+            /**
+             * @brief Record that a player ate
+             *
+             * @param player Player that ate
+             * @param now Time of the meal
+             */
+            void feed(const ServerPlayer &player, Clock::time_point now);
+
+            /**
+             * @brief Get the time elapsed since a player last ate
+             *
+             * @param player Player of the table
+             * @param now Current time
+             * @return Clock::duration Elapsed time, zero for a player without slot
+             */
+            Clock::duration sinceMeal(const ServerPlayer &player, Clock::time_point now) const;
+
+            /**
+             * @brief Find the players that last ate at or before a time
+             *
+             * @param threshold Latest meal time selected
+             * @param out Receives the selected players, not cleared
+             */
+            void collectHungry(Clock::time_point threshold,
+                std::vector<std::shared_ptr<ServerPlayer>> &out) const;
+
+            /**
+             * @brief Get the oldest last meal of the table
+             *
+             * @return std::optional<Clock::time_point> Nothing for an empty table
+             */
+            std::optional<Clock::time_point> oldestMeal() const;
+
+            /**
+             * @brief Count the players standing on a tile
+             *
+             * @param x X coordinate of the tile
+             * @param y Y coordinate of the tile
+             * @return size_t Number of players on the tile
+             */
+            size_t countOnTile(size_t x, size_t y) const;
+
+            /**
+             * @brief Find the players standing on a tile
+             *
+             * @param x X coordinate of the tile
+             * @param y Y coordinate of the tile
+             * @param level Only select this level, 0 for every level
+             * @return std::vector<std::weak_ptr<ServerPlayer>> Selected players
+             */
+            std::vector<std::weak_ptr<ServerPlayer>> playersOnTile(
+                size_t x, size_t y, size_t level = 0) const;
+
+            /**
+             * @brief Visit every player with its hot fields
+             *
+             * @param callback Called with the ServerPlayer, x, y and
+             * orientation of each slot, under the table lock
+             */
+            template <typename Callback>
+            void forEachPlayer(Callback &&callback) const
+            {
+                std::lock_guard<std::mutex> lock(this->_mutex);
+
+                for (size_t slot = 0; slot < this->_players.size(); slot += 1)
+                    callback(*this->_players[slot], this->_x[slot],
+                        this->_y[slot],
+                        static_cast<Orientation>(this->_orientation[slot]));
+            }
+
+            /**
+             * @brief Get the number of players in the table
+             *
+             * @return size_t Number of used slots
+             */
+            size_t size() const;
+
+           private:
+            mutable std::mutex _mutex;  ///< Guards every array and slot
+
+            std::vector<uint32_t> _x;            ///< X coordinate, by slot
+            std::vector<uint32_t> _y;            ///< Y coordinate, by slot
+            std::vector<uint8_t> _orientation;   ///< Orientation, by slot
+            std::vector<uint8_t> _level;         ///< Level, by slot
+            std::vector<Clock::rep> _lastMeal;   ///< Time of the last meal, by slot
+            std::vector<std::shared_ptr<ServerPlayer>> _players;  ///< Cold data, by slot
+
+            /**
+             * @brief Copy the mirrored fields of a player in its slot
+             *
+             * The caller holds _mutex.
+             *
+             * @param slot Slot of the player
+             * @param player Player to copy
+             */
+            void _store(size_t slot, const ServerPlayer &player);
+        };
+    }  // namespace game
+}  // namespace zappy
@@ -9,6 +9,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <memory>
 
 #include "Client.hpp"
 #include "Player.hpp"
@@ -24,8 +25,12 @@ namespace zappy {
          * including client communication, timing mechanisms, action management, and team
          * association. It handles the server-side representation of connected players
          * with thread-safe operations and lifecycle management.
+         * 
+         * Players are always owned by a shared_ptr, so that a command thread
+         * can keep its player alive after the player dies or disconnects.
          */
-        class ServerPlayer : public Player {
+        class ServerPlayer : public Player,
+                             public std::enable_shared_from_this<ServerPlayer> {
            public:
             /**
              * @brief Constructor for ServerPlayer
@@ -47,8 +52,7 @@ namespace zappy {
                 size_t level = 1)
                 : Player::Player(id, x, y, orientation, level),
                   _user(std::move(user)),
-                  _startTime(std::chrono::steady_clock::now()),
-                  _lifeTime(std::chrono::steady_clock::now()), _team(team)
+                  _startTime(std::chrono::steady_clock::now()), _team(team)
             {
                 constexpr int startFood = 10;
                 this->collectRessource(zappy::game::Resource::FOOD, startFood);
@@ -91,33 +95,6 @@ namespace zappy {
                 return now - _startTime;
             }
 
-            /**
-             * @brief Get elapsed time since player creation or last life reset
-             * 
-             * Calculates the duration since the player was created or since
-             * the last call to resetLifeChrono(). Used for life management
-             * and survival mechanics.
-             * 
-             * @return std::chrono::duration<double> Time elapsed since life timer start
-             */
-            std::chrono::duration<double> getLifeChrono() const
-            {
-                auto now = std::chrono::steady_clock::now();
-                return now - _lifeTime;
-            }
-
-            /**
-             * @brief Reset the life timer
-             * 
-             * Resets the life chronometer to the current time.
-             * Typically called when the player consumes food or performs
-             * actions that affect their survival timer.
-             */
-            void resetLifeChrono()
-            {
-                _lifeTime = std::chrono::steady_clock::now();
-            }
-
             /**
              * @brief Check if player is currently performing an action
              * 
@@ -137,19 +114,27 @@ namespace zappy {
             void setInAction(bool status) { _actionStarted = status; }
 
             /**
-             * @brief Get reference to the player's team
+             * @brief Mark the player as in action if it is not already
              * 
-             * @return zappy::game::ITeams& Reference to the team this player belongs to
+             * The check and the update are a single atomic step, so the game
+             * loop starting a command and an incantation taking the player
+             * as a participant cannot both succeed.
+             * 
+             * @return bool True if the caller now owns the action of the player
              */
-            zappy::game::ITeams &getTeam() { return _team; }
+            bool tryReserve()
+            {
+                bool expected = false;
+
+                return _actionStarted.compare_exchange_strong(expected, true);
+            }
 
             /**
-             * @brief Mutex for thread-safe message operations
+             * @brief Get reference to the player's team
              * 
-             * Protects message-related operations from race conditions
-             * when multiple threads need to send messages to or from this player.
+             * @return zappy::game::ITeams& Reference to the team this player belongs to
              */
-            std::mutex msgMutex;
+            zappy::game::ITeams &getTeam() { return _team; }
 
             /**
              * @brief Atomic flag indicating if player operations should be interrupted
@@ -158,7 +143,20 @@ namespace zappy {
              * should be interrupted, typically when the player disconnects or
              * the server is shutting down.
              */
-            std::atomic<bool> interrupted;
+            std::atomic<bool> interrupted = false;
+
+            /**
+             * @brief Slot of a player outside any PlayerTable
+             */
+            static constexpr size_t noSlot = static_cast<size_t>(-1);
+
+            /**
+             * @brief Index of the player in the PlayerTable of its game
+             * 
+             * The time of its last meal is stored there. Only read or
+             * written under the table lock.
+             */
+            size_t slot = noSlot;
 
            private:
             /**
@@ -177,14 +175,6 @@ namespace zappy {
              */
             std::chrono::steady_clock::time_point _startTime;
 
-            /**
-             * @brief Timestamp for life/survival tracking
-             * 
-             * Used to track player survival time for food consumption
-             * and death mechanics.
-             */
-            std::chrono::steady_clock::time_point _lifeTime;
-
             /**
              * @brief Atomic flag indicating if player is currently performing an action
              * 
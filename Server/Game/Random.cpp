@@ -0,0 +1,43 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Random
+*/
+
+#include "Random.hpp"
+
+/**
+ * @brief Expand the seed with splitmix64, as recommended for xoshiro
+ *
+ * The stream is mixed in first so that generators sharing a seed start
+ * far apart in the sequence.
+ */
+zappy::game::Random::Random(uint64_t seed, uint64_t stream)
+{
+    uint64_t mix = seed ^ (stream * 0xd1342543de82ef95ULL);
+
+    for (auto &word : this->_state) {
+        mix += 0x9e3779b97f4a7c15ULL;
+        uint64_t z = mix;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        word = z ^ (z >> 31);
+    }
+}
+
+void zappy::game::Random::fillCoordinates(size_t count, uint32_t width,
+    uint32_t height, std::vector<Coordinates> &out)
+{
+    this->_raw.resize(count);
+    out.resize(count);
+    for (auto &value : this->_raw)
+        value = this->next();
+
+    const uint64_t *raw = this->_raw.data();
+    Coordinates *coordinates = out.data();
+    for (size_t i = 0; i < count; i += 1) {
+        coordinates[i].x = _reduce(static_cast<uint32_t>(raw[i] >> 32), width);
+        coordinates[i].y = _reduce(static_cast<uint32_t>(raw[i]), height);
+    }
+}
@@ -0,0 +1,110 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Random
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace zappy {
+    namespace game {
+        /**
+         * @brief Tile coordinates drawn by Random::fillCoordinates
+         */
+        struct Coordinates {
+            uint32_t x; /**< X coordinate, below the map width */
+            uint32_t y; /**< Y coordinate, below the map height */
+        };
+
+        /**
+         * @brief Seedable xoshiro256** generator
+         *
+         * Replaces std::rand: it has no global state, so every owner keeps
+         * its own generator and nothing is serialized on libc. The same
+         * seed and stream always give the same sequence, on every platform.
+         * A generator is not thread-safe, it must be used by one thread at a
+         * time.
+         */
+        class Random {
+           public:
+            /**
+             * @brief Seed a generator
+             *
+             * @param seed Seed of the game
+             * @param stream Index of the generator among the ones seeded
+             *               from the same seed, each stream gives an
+             *               independent sequence
+             */
+            explicit Random(uint64_t seed, uint64_t stream = 0);
+
+            /**
+             * @brief Draw the next 64 bits of the sequence
+             *
+             * @return uint64_t Uniformly distributed value
+             */
+            uint64_t next()
+            {
+                const uint64_t result = _rotl(this->_state[1] * 5, 7) * 9;
+                const uint64_t t = this->_state[1] << 17;
+
+                this->_state[2] ^= this->_state[0];
+                this->_state[3] ^= this->_state[1];
+                this->_state[1] ^= this->_state[2];
+                this->_state[0] ^= this->_state[3];
+                this->_state[2] ^= t;
+                this->_state[3] = _rotl(this->_state[3], 45);
+                return result;
+            }
+
+            /**
+             * @brief Draw a value in [0, bound)
+             *
+             * Uses a multiply-shift reduction instead of a modulo: no
+             * division, and the bias is spread over the whole range instead
+             * of favouring the low values.
+             *
+             * @param bound Exclusive upper bound, greater than 0
+             * @return uint32_t Value below bound
+             */
+            uint32_t below(uint32_t bound)
+            {
+                return _reduce(static_cast<uint32_t>(this->next() >> 32), bound);
+            }
+
+            /**
+             * @brief Draw many tile coordinates at once
+             *
+             * The raw values are generated first, then reduced to the map
+             * size in a separate loop the compiler can vectorize. One draw
+             * gives both coordinates of a tile.
+             *
+             * @param count Number of coordinates to draw
+             * @param width Map width, greater than 0
+             * @param height Map height, greater than 0
+             * @param out Filled with count coordinates, reused between calls
+             */
+            void fillCoordinates(size_t count, uint32_t width, uint32_t height,
+                std::vector<Coordinates> &out);
+
+           private:
+            static uint64_t _rotl(uint64_t value, int shift)
+            {
+                return (value << shift) | (value >> (64 - shift));
+            }
+
+            static uint32_t _reduce(uint32_t value, uint32_t bound)
+            {
+                return static_cast<uint32_t>(
+                    (static_cast<uint64_t>(value) * bound) >> 32);
+            }
+
+            uint64_t _state[4]; /**< Generator state, never all zero */
+            std::vector<uint64_t> _raw; /**< Scratch buffer of fillCoordinates */
+        };
+    }  // namespace game
+}  // namespace zappy
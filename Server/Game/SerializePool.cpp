@@ -0,0 +1,200 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** SerializePool
+*/
+
+#include "SerializePool.hpp"
+#include "MessageFormat.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+/**
+ * @brief State of one render, shared by the threads working on it
+ */
+struct zappy::game::SerializePool::Render {
+    std::shared_ptr<const MapView> view;      ///< Map being rendered
+    size_t tileCount = 0;                     ///< Tiles of the map
+    size_t partCount = 0;                     ///< Parts of the render
+    bool withOffsets = false;                 ///< Whether line starts are recorded
+    std::vector<std::string> parts;           ///< Lines of each part
+    std::vector<std::vector<size_t>> offsets; ///< Line starts of each part
+    std::atomic<size_t> nextPart = 0;         ///< Next part to claim
+    std::atomic<size_t> remaining = 0;        ///< Parts not done yet
+    Done done;                                ///< Set for a render nobody waits for
+
+    std::mutex mutex;                  ///< Guards the members below
+    std::condition_variable finished;  ///< Signals the waiting thread
+    bool complete = false;             ///< Every part is concatenated
+    std::string tiles;                 ///< Concatenated lines
+    std::vector<size_t> tileOffsets;   ///< Concatenated line starts
+};
+
+zappy::game::SerializePool::SerializePool(size_t workers)
+    : _workers(std::max<size_t>(workers, 1))
+{
+}
+
+size_t zappy::game::SerializePool::defaultWorkers()
+{
+    return std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+}
+
+void zappy::game::SerializePool::renderTiles(
+    std::shared_ptr<const MapView> view, Done done)
+{
+    auto render = _makeRender(std::move(view), false);
+
+    render->done = std::move(done);
+    if (this->_help(render, render->partCount) == 0)
+        _renderParts(*render);
+}
+
+std::string zappy::game::SerializePool::renderTiles(
+    std::shared_ptr<const MapView> view, std::vector<size_t> &offsets)
+{
+    auto render = _makeRender(std::move(view), true);
+
+    this->_help(render, render->partCount - 1);
+    _renderParts(*render);
+
+    std::unique_lock<std::mutex> lock(render->mutex);
+    render->finished.wait(lock, [&render]() { return render->complete; });
+    offsets.swap(render->tileOffsets);
+    return std::move(render->tiles);
+}
+
+void zappy::game::SerializePool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        this->_stopped = true;
+        this->_tasks.clear();
+    }
+    this->_wake.notify_all();
+    for (auto &thread : this->_threads)
+        thread.join();
+    this->_threads.clear();
+}
+
+std::shared_ptr<zappy::game::SerializePool::Render>
+zappy::game::SerializePool::_makeRender(
+    std::shared_ptr<const MapView> view, bool withOffsets)
+{
+    auto render = std::make_shared<Render>();
+    size_t tileCount = view->getWidth() * view->getHeight();
+    size_t partCount = std::max<size_t>(
+        (tileCount + tilesPerPart - 1) / tilesPerPart, 1);
+
+    render->view = std::move(view);
+    render->tileCount = tileCount;
+    render->partCount = partCount;
+    render->withOffsets = withOffsets;
+    render->parts.resize(partCount);
+    render->offsets.resize(partCount);
+    render->remaining = partCount;
+    return render;
+}
+
+size_t zappy::game::SerializePool::_help(
+    const std::shared_ptr<Render> &render, size_t helpers)
+{
+    helpers = std::min(helpers, this->_workers);
+    if (helpers == 0)
+        return 0;
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+
+        if (this->_stopped)
+            return 0;
+        while (this->_threads.size() < this->_workers)
+            this->_threads.emplace_back(&SerializePool::_work, this);
+        for (size_t idx = 0; idx < helpers; idx += 1)
+            this->_tasks.emplace_back([render]() { _renderParts(*render); });
+    }
+    this->_wake.notify_all();
+    return helpers;
+}
+
+void zappy::game::SerializePool::_renderParts(Render &render)
+{
+    const MapView &view = *render.view;
+    size_t height = view.getHeight();
+
+    for (size_t part = render.nextPart++; part < render.partCount;
+        part = render.nextPart++) {
+        std::string &out = render.parts[part];
+        size_t begin = part * tilesPerPart;
+        size_t end = std::min(begin + tilesPerPart, render.tileCount);
+
+        out.reserve((end - begin) * 24);
+        if (render.withOffsets)
+            render.offsets[part].reserve(end - begin);
+        for (size_t idx = begin; idx < end; idx += 1) {
+            size_t x = idx / height;
+            size_t y = idx % height;
+            const auto &quantities = view.getResources(x, y);
+
+            if (render.withOffsets)
+                render.offsets[part].push_back(out.size());
+            zappy::server::formatTo(out, "bct ", x, ' ', y, ' ',
+                quantities[0], ' ', quantities[1], ' ', quantities[2], ' ',
+                quantities[3], ' ', quantities[4], ' ', quantities[5], ' ',
+                quantities[6], '\n');
+        }
+        if (render.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            _finish(render);
+    }
+}
+
+void zappy::game::SerializePool::_finish(Render &render)
+{
+    std::string tiles;
+    std::vector<size_t> tileOffsets;
+    size_t total = 0;
+
+    for (auto &part : render.parts)
+        total += part.size();
+    tiles.reserve(total);
+    if (render.withOffsets)
+        tileOffsets.reserve(render.tileCount + 1);
+    for (size_t part = 0; part < render.partCount; part += 1) {
+        for (size_t offset : render.offsets[part])
+            tileOffsets.push_back(tiles.size() + offset);
+        tiles.append(render.parts[part]);
+        std::string().swap(render.parts[part]);
+    }
+    if (render.withOffsets)
+        tileOffsets.push_back(tiles.size());
+    if (render.done) {
+        render.done(std::move(tiles));
+        return;
+    }
+    std::lock_guard<std::mutex> lock(render.mutex);
+    render.tiles = std::move(tiles);
+    render.tileOffsets = std::move(tileOffsets);
+    render.complete = true;
+    render.finished.notify_all();
+}
+
+void zappy::game::SerializePool::_work()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+
+            this->_wake.wait(lock, [this]() {
+                return this->_stopped || !this->_tasks.empty();
+            });
+            if (this->_tasks.empty())
+                return;
+            task = std::move(this->_tasks.front());
+            this->_tasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,154 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** SerializePool
+*/
+
+#pragma once
+
+#include "MapView.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zappy {
+    namespace game {
+        /**
+         * @brief Worker threads rendering the bct lines of large maps
+         *
+         * A render splits the tiles, in mct order, into parts of
+         * tilesPerPart tiles. Every thread working on it claims the next
+         * part until none is left, each part being rendered into its own
+         * buffer, and the thread finishing the last part concatenates them
+         * in order. The tiles are read from a MapView, so the game keeps
+         * running while they are rendered.
+         *
+         * The threads are only started by the first render with more than
+         * one part.
+         */
+        class SerializePool {
+           public:
+            /**
+             * @brief Number of tiles rendered by a part
+             */
+            static constexpr size_t tilesPerPart = 4096;
+
+            /**
+             * @brief Called with the rendered lines once every part is done
+             */
+            using Done = std::function<void(std::string &&tiles)>;
+
+            /**
+             * @brief Constructor for SerializePool
+             *
+             * @param workers Number of threads, at least 1
+             */
+            explicit SerializePool(size_t workers = defaultWorkers());
+
+            /**
+             * @brief Stop the threads, see stop()
+             */
+            ~SerializePool() { this->stop(); }
+
+            SerializePool(const SerializePool &) = delete;
+            SerializePool &operator=(const SerializePool &) = delete;
+
+            /**
+             * @brief Get the number of threads used when none is given
+             *
+             * @return size_t Half the hardware threads, between 1 and 4
+             */
+            static size_t defaultWorkers();
+
+            /**
+             * @brief Render every tile without waiting for the result
+             *
+             * Renders in the calling thread if the pool is stopped.
+             *
+             * @param view Map to render
+             * @param done Called from the thread finishing the last part
+             */
+            void renderTiles(std::shared_ptr<const MapView> view, Done done);
+
+            /**
+             * @brief Render every tile and wait for the result
+             *
+             * The calling thread renders parts too, so the result does not
+             * depend on the threads being free, or running at all.
+             *
+             * @param view Map to render
+             * @param offsets Receives the start of the line of each tile,
+             *                index x * height + y, then the total size
+             * @return std::string One bct line per tile, in mct order
+             */
+            std::string renderTiles(std::shared_ptr<const MapView> view,
+                std::vector<size_t> &offsets);
+
+            /**
+             * @brief Drop the parts not started yet and join the threads
+             *
+             * Called when the game stops, so that no render completes once
+             * the clients are gone. Renders started later run in the
+             * calling thread.
+             */
+            void stop();
+
+           private:
+            struct Render;
+
+            size_t _workers; ///< Number of threads to start
+
+            std::mutex _mutex;                ///< Guards every member below
+            std::condition_variable _wake;    ///< Signals a task or stop()
+            std::deque<std::function<void()>> _tasks; ///< Tasks not started yet
+            std::vector<std::thread> _threads; ///< Started threads
+            bool _stopped = false;            ///< Set by stop()
+
+            /**
+             * @brief Prepare a render of every tile of a view
+             *
+             * @param view Map to render
+             * @param withOffsets Whether to record the start of each line
+             * @return std::shared_ptr<Render> The render, no part claimed
+             */
+            static std::shared_ptr<Render> _makeRender(
+                std::shared_ptr<const MapView> view, bool withOffsets);
+
+            /**
+             * @brief Queue threads to help with a render
+             *
+             * @param render Render to help with
+             * @param helpers Number of threads wanted
+             * @return size_t Number of helpers queued, 0 once stopped
+             */
+            size_t _help(const std::shared_ptr<Render> &render, size_t helpers);
+
+            /**
+             * @brief Render parts until none is left to claim
+             *
+             * @param render Render to work on
+             */
+            static void _renderParts(Render &render);
+
+            /**
+             * @brief Concatenate the parts, from the thread finishing the last one
+             *
+             * @param render Render whose parts are all done
+             */
+            static void _finish(Render &render);
+
+            /**
+             * @brief Loop of a thread, runs tasks until stop()
+             */
+            void _work();
+        };
+    }  // namespace game
+}  // namespace zappy
@@ -0,0 +1,307 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Snapshot
+*/
+
+#include "Error.hpp"
+#include "Game.hpp"
+#include "ServerPlayer.hpp"
+#include "Snapshot.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    /**
+     * @brief Read-only memory mapping of a whole file
+     */
+    class MappedFile {
+       public:
+        explicit MappedFile(const std::string &path)
+        {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            struct stat info {};
+
+            if (fd == -1)
+                throw zappy::error::SnapshotError(
+                    "Unable to open snapshot " + path);
+            if (::fstat(fd, &info) == -1 || info.st_size == 0) {
+                ::close(fd);
+                throw zappy::error::SnapshotError(
+                    "Empty or unreadable snapshot " + path);
+            }
+            this->_size = static_cast<size_t>(info.st_size);
+            this->_data = ::mmap(nullptr, this->_size, PROT_READ, MAP_PRIVATE,
+                fd, 0);
+            ::close(fd);
+            if (this->_data == MAP_FAILED)
+                throw zappy::error::SnapshotError(
+                    "Unable to map snapshot " + path);
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        ~MappedFile() { ::munmap(this->_data, this->_size); }
+
+        const char *data() const { return static_cast<const char *>(this->_data); }
+
+        size_t size() const { return this->_size; }
+
+       private:
+        void *_data = nullptr;
+        size_t _size = 0;
+    };
+
+    size_t tilesSize(const zappy::game::snapshot::Header &header)
+    {
+        return static_cast<size_t>(header.width) * header.height *
+               zappy::game::RESOURCE_QUANTITY * sizeof(uint32_t);
+    }
+
+    /**
+     * @brief Add the size of count records to a total
+     *
+     * @return bool False if the size does not fit in a size_t
+     */
+    bool addRecords(size_t &total, size_t count, size_t recordSize)
+    {
+        size_t bytes = 0;
+
+        return !__builtin_mul_overflow(count, recordSize, &bytes) &&
+               !__builtin_add_overflow(total, bytes, &total);
+    }
+
+    /**
+     * @brief Check the header of a mapped snapshot against its size
+     *
+     * The expected size is computed with overflow checks, a forged
+     * header cannot wrap it around to the real file size.
+     */
+    const zappy::game::snapshot::Header &checkHeader(const MappedFile &file)
+    {
+        using namespace zappy::game::snapshot;
+
+        if (file.size() < sizeof(Header))
+            throw zappy::error::SnapshotError("Truncated snapshot header");
+        const auto &header = *reinterpret_cast<const Header *>(file.data());
+
+        if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+            throw zappy::error::SnapshotError("Not a zappy snapshot");
+        if (header.version != version)
+            throw zappy::error::SnapshotError(
+                "Unsupported snapshot version " +
+                std::to_string(header.version));
+        if (header.width == 0 || header.height == 0)
+            throw zappy::error::SnapshotError("Snapshot map is empty");
+        size_t expected = sizeof(Header);
+        size_t tiles = 0;
+
+        if (__builtin_mul_overflow(static_cast<size_t>(header.width),
+                static_cast<size_t>(header.height), &tiles) ||
+            !addRecords(expected, tiles,
+                zappy::game::RESOURCE_QUANTITY * sizeof(uint32_t)) ||
+            !addRecords(expected, header.teamCount, sizeof(TeamRecord)) ||
+            !addRecords(expected, header.eggCount, sizeof(EggRecord)) ||
+            !addRecords(expected, header.playerCount, sizeof(PlayerRecord)) ||
+            file.size() != expected)
+            throw zappy::error::SnapshotError("Snapshot size does not match its header");
+        return header;
+    }
+
+    template <typename T>
+    void writeRecords(std::ofstream &file, const std::vector<T> &records)
+    {
+        file.write(reinterpret_cast<const char *>(records.data()),
+            records.size() * sizeof(T));
+    }
+}  // namespace
+
+zappy::game::snapshot::Header zappy::game::snapshot::readHeader(
+    const std::string &path)
+{
+    MappedFile file(path);
+
+    return checkHeader(file);
+}
+
+void zappy::game::Game::saveSnapshot(const std::string &path)
+{
+    snapshot::Header header{};
+    std::vector<snapshot::TeamRecord> teams;
+    std::vector<snapshot::EggRecord> eggs;
+    std::vector<snapshot::PlayerRecord> players;
+    std::vector<uint32_t> row(this->_map.getWidth() * RESOURCE_QUANTITY);
+    auto now = this->_clock.now();
+
+    {
+        std::lock_guard<std::mutex> eggLock(this->_map._eggMutex);
+
+        for (auto &team : this->_teamList) {
+            if (team->getName() == "GRAPHIC")
+                continue;
+            if (team->getName().size() > snapshot::maxTeamName)
+                throw error::SnapshotError(
+                    "Team name too long for a snapshot: " + team->getName());
+            uint32_t teamIdx = teams.size();
+            snapshot::TeamRecord teamRecord{};
+
+            std::memcpy(teamRecord.name, team->getName().data(),
+                team->getName().size());
+            teams.push_back(teamRecord);
+            team->forEachPlayer([this, &players, teamIdx, now](ServerPlayer &player) {
+                snapshot::PlayerRecord record{};
+                const auto &inventory = player.getInventory().getResources();
+
+                record.id = player.getId();
+                record.x = player.x;
+                record.y = player.y;
+                record.team = teamIdx;
+                record.orientation = static_cast<uint32_t>(player.orientation);
+                record.level = player.level;
+                for (size_t idx = 0; idx < RESOURCE_QUANTITY; idx += 1)
+                    record.inventory[idx] = inventory[idx];
+                record.lifeElapsedMs =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        this->_players.sinceMeal(player, now)).count();
+                players.push_back(record);
+            });
+            auto restored = this->_restoredPlayers.find(team->getName());
+            if (restored == this->_restoredPlayers.end())
+                continue;
+            for (auto record : restored->second) {
+                record.team = teamIdx;
+                players.push_back(record);
+            }
+        }
+        this->_map.getEggs().forEach([&eggs](const Egg &egg) {
+            eggs.push_back({egg.getId(), egg.getFatherId(), egg.x, egg.y});
+        });
+        header.nextEggId = this->_map.getNextEggId();
+        header.nextPlayerId = this->_idPlayerTot;
+    }
+    std::memcpy(header.magic, snapshot::magic, sizeof(snapshot::magic));
+    header.version = snapshot::version;
+    header.width = this->_map.getWidth();
+    header.height = this->_map.getHeight();
+    header.teamCount = teams.size();
+    header.eggCount = eggs.size();
+    header.playerCount = players.size();
+
+    std::string tmpPath = path + ".tmp";
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw error::SnapshotError("Unable to create snapshot " + tmpPath);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    auto view = this->_map.acquireView();
+    for (size_t y = 0; y < header.height; y += 1) {
+        for (size_t x = 0; x < header.width; x += 1) {
+            const auto &resources = view->getResources(x, y);
+            for (size_t idx = 0; idx < RESOURCE_QUANTITY; idx += 1)
+                row[x * RESOURCE_QUANTITY + idx] = resources[idx];
+        }
+        writeRecords(file, row);
+    }
+    writeRecords(file, teams);
+    writeRecords(file, eggs);
+    writeRecords(file, players);
+    file.close();
+    if (!file || std::rename(tmpPath.c_str(), path.c_str()) != 0)
+        throw error::SnapshotError("Unable to write snapshot " + path);
+}
+
+void zappy::game::Game::_loadSnapshot(const std::string &path)
+{
+    MappedFile file(path);
+    const auto &header = checkHeader(file);
+
+    if (header.width != this->_map.getWidth() ||
+        header.height != this->_map.getHeight())
+        throw error::SnapshotError("Snapshot map size does not match the game");
+
+    const char *cursor = file.data() + sizeof(snapshot::Header);
+    const auto *tiles = reinterpret_cast<const uint32_t *>(cursor);
+    for (size_t y = 0; y < header.height; y += 1) {
+        for (size_t x = 0; x < header.width; x += 1) {
+            auto &tile = this->_map.getTile(x, y);
+            for (size_t idx = 0; idx < RESOURCE_QUANTITY; idx += 1, tiles += 1) {
+                if (*tiles != 0)
+                    tile.addResource(static_cast<Resource>(idx), *tiles);
+            }
+        }
+    }
+    cursor += tilesSize(header);
+
+    const auto *teams = reinterpret_cast<const snapshot::TeamRecord *>(cursor);
+    std::vector<std::string> teamNames;
+    for (size_t idx = 0; idx < header.teamCount; idx += 1) {
+        const auto &record = teams[idx];
+        std::string name(record.name, strnlen(record.name, sizeof(record.name)));
+        auto team = std::find_if(this->_teamList.begin(), this->_teamList.end(),
+            [&name](const std::shared_ptr<ITeams> &candidate) {
+                return candidate->getName() == name;
+            });
+        if (name.size() > snapshot::maxTeamName || team == this->_teamList.end())
+            throw error::SnapshotError("Snapshot team " + name + " is not in the game (-n)");
+        teamNames.push_back(std::move(name));
+    }
+    cursor += header.teamCount * sizeof(snapshot::TeamRecord);
+
+    auto inMap = [&header](int32_t x, int32_t y) {
+        return x >= 0 && y >= 0 && static_cast<uint32_t>(x) < header.width &&
+               static_cast<uint32_t>(y) < header.height;
+    };
+    const auto *eggs = reinterpret_cast<const snapshot::EggRecord *>(cursor);
+    for (size_t idx = 0; idx < header.eggCount; idx += 1) {
+        const auto &record = eggs[idx];
+        if (!inMap(record.x, record.y))
+            throw error::SnapshotError("Snapshot egg out of the map");
+        this->_map.restoreEgg(
+            Egg(record.id, record.fatherId, record.x, record.y));
+    }
+    cursor += header.eggCount * sizeof(snapshot::EggRecord);
+
+    const auto *players = reinterpret_cast<const snapshot::PlayerRecord *>(cursor);
+    for (size_t idx = 0; idx < header.playerCount; idx += 1) {
+        const auto &record = players[idx];
+        if (record.team >= header.teamCount || !inMap(record.x, record.y) ||
+            record.orientation > static_cast<uint32_t>(Orientation::WEST) ||
+            record.level < static_cast<uint32_t>(minLevel) ||
+            record.level > static_cast<uint32_t>(maxLevel))
+            throw error::SnapshotError("Invalid player in snapshot");
+        this->_restoredPlayers[teamNames[record.team]].push_back(record);
+    }
+    this->_map.setNextEggId(header.nextEggId);
+    this->_idPlayerTot = header.nextPlayerId;
+}
+
+std::shared_ptr<zappy::game::ServerPlayer> zappy::game::Game::_takeRestoredPlayer(
+    std::shared_ptr<zappy::game::ITeams> team, zappy::server::Client &user)
+{
+    auto restored = this->_restoredPlayers.find(team->getName());
+    if (restored == this->_restoredPlayers.end() || restored->second.empty())
+        return nullptr;
+    snapshot::PlayerRecord record = restored->second.back();
+    restored->second.pop_back();
+
+    user.setState(zappy::server::ClientState::CONNECTED);
+    auto newPlayer = std::make_shared<zappy::game::ServerPlayer>(std::move(user),
+        record.id, record.x, record.y, static_cast<Orientation>(record.orientation),
+        *team, record.level);
+    Inventory inventory;
+    for (size_t idx = 0; idx < RESOURCE_QUANTITY; idx += 1)
+        inventory.addResource(static_cast<Resource>(idx), record.inventory[idx]);
+    newPlayer->setInventory(inventory);
+    newPlayer->teamName = team->getName();
+    team->addPlayer(newPlayer);
+    this->_players.add(newPlayer, this->_clock.now() - std::chrono::milliseconds(record.lifeElapsedMs));
+    this->_playerList.push_back(newPlayer);
+    return newPlayer;
+}
@@ -0,0 +1,107 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** Snapshot
+*/
+
+#pragma once
+
+#include "Resource.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace zappy {
+    namespace game {
+        namespace snapshot {
+            /**
+             * @brief Binary game-state snapshot layout
+             *
+             * A snapshot file is a Header followed by fixed-size sections,
+             * in this order:
+             *   - width * height tiles of RESOURCE_QUANTITY uint32_t, row by row
+             *   - teamCount TeamRecord
+             *   - eggCount EggRecord
+             *   - playerCount PlayerRecord
+             *
+             * Every field is a native-endian 32-bit integer, so each section
+             * is a plain array that can be read in place from a memory
+             * mapping of the file.
+             */
+
+            /** @brief Magic bytes at the start of every snapshot */
+            constexpr char magic[4] = {'Z', 'P', 'Y', 'S'};
+
+            /** @brief Layout version, bumped on every format change */
+            constexpr uint32_t version = 1;
+
+            /** @brief Longest team name a snapshot can hold, NUL excluded */
+            constexpr size_t maxTeamName = 63;
+
+            /**
+             * @brief First bytes of a snapshot file
+             */
+            struct Header {
+                char magic[4];        /**< Always snapshot::magic */
+                uint32_t version;     /**< Always snapshot::version */
+                uint32_t width;       /**< Map width */
+                uint32_t height;      /**< Map height */
+                uint32_t teamCount;   /**< Number of TeamRecord */
+                uint32_t eggCount;    /**< Number of EggRecord */
+                uint32_t playerCount; /**< Number of PlayerRecord */
+                int32_t nextEggId;    /**< Id given to the next egg */
+                int32_t nextPlayerId; /**< Id given to the next player */
+            };
+
+            /**
+             * @brief Player team, referenced by index from PlayerRecord
+             */
+            struct TeamRecord {
+                char name[maxTeamName + 1]; /**< NUL-terminated team name */
+            };
+
+            /**
+             * @brief Egg laid on the map
+             */
+            struct EggRecord {
+                int32_t id;       /**< Egg id */
+                int32_t fatherId; /**< Id of the laying player, -1 if none */
+                int32_t x;        /**< X coordinate */
+                int32_t y;        /**< Y coordinate */
+            };
+
+            /**
+             * @brief Player alive when the snapshot was taken
+             */
+            struct PlayerRecord {
+                int32_t id;                                /**< Player id */
+                int32_t x;                                 /**< X coordinate */
+                int32_t y;                                 /**< Y coordinate */
+                uint32_t team;                             /**< Index of its TeamRecord */
+                uint32_t orientation;                      /**< Orientation value */
+                uint32_t level;                            /**< Elevation level */
+                uint32_t inventory[RESOURCE_QUANTITY];     /**< Inventory quantities */
+                uint32_t lifeElapsedMs;                    /**< Time since last food tick */
+            };
+
+            static_assert(sizeof(Header) == 36, "Header must not be padded");
+            static_assert(sizeof(EggRecord) == 16, "EggRecord must not be padded");
+            static_assert(sizeof(PlayerRecord) ==
+                              (7 + RESOURCE_QUANTITY) * sizeof(uint32_t),
+                "PlayerRecord must not be padded");
+
+            /**
+             * @brief Read and validate the header of a snapshot file
+             *
+             * Used before the game exists, to size the map from the file.
+             *
+             * @param path Snapshot file path
+             * @return Header Validated header
+             * @throw zappy::error::SnapshotError if the file is not a valid snapshot
+             */
+            Header readHeader(const std::string &path);
+        }  // namespace snapshot
+    }  // namespace game
+}  // namespace zappy
@@ -12,6 +12,7 @@ void zappy::game::ATeams::removePlayer(int clientSocket)
     std::lock_guard<std::mutex> lock(this->_playerListLock);
     for (auto it = this->_playerList.begin(); it != this->_playerList.end(); it += 1) {
         if ((*it)->getClient().getSocket() == clientSocket) {
+            this->_levelCounts[_bucket((*it)->level)] -= 1;
             this->_playerList.erase(it);
             return;
         }
@@ -26,5 +27,34 @@ const std::vector<std::shared_ptr<zappy::game::ServerPlayer>> zappy::game::ATeam
 void zappy::game::ATeams::addPlayer(std::shared_ptr<ServerPlayer> player)
 {
     std::lock_guard<std::mutex> lock(this->_playerListLock);
+    this->_levelCounts[_bucket(player->level)] += 1;
     this->_playerList.push_back(std::move(player));
 }
+
+void zappy::game::ATeams::elevatePlayer(ServerPlayer &player)
+{
+    std::lock_guard<std::mutex> lock(this->_playerListLock);
+    this->_levelCounts[_bucket(player.level)] -= 1;
+    player.level += 1;
+    this->_levelCounts[_bucket(player.level)] += 1;
+}
+
+size_t zappy::game::ATeams::countPlayersFromLevel(size_t level) const
+{
+    size_t count = 0;
+
+    for (size_t i = _bucket(level); i < maxTeamLevel; i += 1)
+        count += this->_levelCounts[i].load(std::memory_order_relaxed);
+    return count;
+}
+
+zappy::game::TeamStats zappy::game::ATeams::getStats() const
+{
+    TeamStats stats;
+
+    for (size_t i = 0; i < maxTeamLevel; i += 1) {
+        stats.levels[i] = this->_levelCounts[i].load(std::memory_order_relaxed);
+        stats.players += stats.levels[i];
+    }
+    return stats;
+}
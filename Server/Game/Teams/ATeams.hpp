@@ -8,6 +8,8 @@
 #pragma once
 
 #include "ITeams.hpp"
+#include <algorithm>
+#include <atomic>
 
 namespace zappy {
     namespace game {
@@ -36,9 +38,9 @@ namespace zappy {
             /**
                  * @brief Get the team name
                  * 
-                 * @return std::string The name of the team
+                 * @return const std::string& The name of the team
                  */
-            std::string getName() const { return _name; }
+            const std::string &getName() const { return _name; }
 
             /**
                  * @brief Add a player to the team
@@ -81,7 +83,65 @@ namespace zappy {
                  */
             int getTeamId() const { return this->_teamId; }
 
+            /**
+                 * @brief Raise a player of the team by one level
+                 * 
+                 * The level and the histogram change under _playerListLock,
+                 * so a concurrent removal always sees a consistent level.
+                 * 
+                 * @param player Player of this team to elevate
+                 */
+            void elevatePlayer(ServerPlayer &player);
+
+            /**
+                 * @brief Count the players of the team at or above a level
+                 * 
+                 * @param level Lowest level counted
+                 * @return size_t Number of players at that level or higher
+                 */
+            size_t countPlayersFromLevel(size_t level) const;
+
+            /**
+                 * @brief Get the level histogram of the team
+                 * 
+                 * @return TeamStats Players of the team, in total and per level
+                 */
+            TeamStats getStats() const;
+
+            /**
+                 * @brief Lock the player list for direct access
+                 * 
+                 * @return std::unique_lock<std::mutex> Lock on _playerListLock
+                 */
+            std::unique_lock<std::mutex> lockPlayerList() const
+            {
+                return std::unique_lock<std::mutex>(this->_playerListLock);
+            }
+
+            /**
+                 * @brief Get the player list without copying it
+                 * 
+                 * @return const std::vector<std::shared_ptr<ServerPlayer>>& The team's player list
+                 */
+            const std::vector<std::shared_ptr<ServerPlayer>> &
+            getPlayerListRef() const
+            {
+                return this->_playerList;
+            }
+
            private:
+            /**
+                 * @brief Histogram bucket of a level
+                 * 
+                 * @param level Player level
+                 * @return size_t Index in _levelCounts, levels above
+                 * maxTeamLevel share the last bucket
+                 */
+            static size_t _bucket(size_t level)
+            {
+                return std::min(std::max<size_t>(level, 1), maxTeamLevel) - 1;
+            }
+
             /**
                  * @brief The name of the team
                  * 
@@ -107,6 +167,14 @@ namespace zappy {
                  */
             std::vector<std::shared_ptr<ServerPlayer>> _playerList;
 
+            /**
+                 * @brief Number of players of the team at each level
+                 * 
+                 * Written under _playerListLock together with _playerList and
+                 * the player levels, read without lock by the win check.
+                 */
+            std::array<std::atomic<size_t>, maxTeamLevel> _levelCounts{};
+
             /**
                  * @brief Mutex for thread-safe player list operations
                  * 
@@ -114,7 +182,7 @@ namespace zappy {
                  * threads attempt to add, remove, or access players simultaneously.
                  * Ensures data consistency in multi-threaded server environment.
                  */
-            std::mutex _playerListLock;
+            mutable std::mutex _playerListLock;
         };
     }  // namespace game
 }  // namespace zappy
@@ -9,6 +9,7 @@
 
 #include "Client.hpp"
 #include "ServerPlayer.hpp"
+#include <array>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -16,6 +17,17 @@
 
 namespace zappy {
     namespace game {
+        /** @brief Highest level counted by the team level histograms */
+        constexpr size_t maxTeamLevel = 8;
+
+        /**
+         * @brief Snapshot of a team level histogram
+         */
+        struct TeamStats {
+            size_t players = 0;                         /**< Players in the team */
+            std::array<size_t, maxTeamLevel> levels{};  /**< Players per level, level 1 first */
+        };
+
         /**
          * @brief Interface for team management in the Zappy game
          * 
@@ -32,9 +44,9 @@ namespace zappy {
                  * Pure virtual method that must be implemented by concrete team classes
                  * to return the team's identifying name.
                  * 
-                 * @return std::string The name of the team
+                 * @return const std::string& The name of the team
                  */
-            virtual std::string getName() const = 0;
+            virtual const std::string &getName() const = 0;
 
             /**
                  * @brief Remove a player from the team
@@ -79,6 +91,70 @@ namespace zappy {
                  * @return int The unique identifier of the team
                  */
             virtual int getTeamId() const = 0;
+
+            /**
+                 * @brief Raise a player of the team by one level
+                 * 
+                 * Must be used instead of changing the level directly so that
+                 * the team level histogram stays up to date.
+                 * 
+                 * @param player Player of this team to elevate
+                 */
+            virtual void elevatePlayer(ServerPlayer &player) = 0;
+
+            /**
+                 * @brief Count the players of the team at or above a level
+                 * 
+                 * Reads the level histogram, the players are not visited.
+                 * 
+                 * @param level Lowest level counted
+                 * @return size_t Number of players at that level or higher
+                 */
+            virtual size_t countPlayersFromLevel(size_t level) const = 0;
+
+            /**
+                 * @brief Get the level histogram of the team
+                 * 
+                 * @return TeamStats Players of the team, in total and per level
+                 */
+            virtual TeamStats getStats() const = 0;
+
+            /**
+                 * @brief Lock the player list for direct access
+                 * 
+                 * @return std::unique_lock<std::mutex> Lock held while the list is read
+                 */
+            virtual std::unique_lock<std::mutex> lockPlayerList() const = 0;
+
+            /**
+                 * @brief Get the player list without copying it
+                 * 
+                 * Must only be read while holding the lock returned by
+                 * lockPlayerList().
+                 * 
+                 * @return const std::vector<std::shared_ptr<ServerPlayer>>& The team's player list
+                 */
+            virtual const std::vector<std::shared_ptr<ServerPlayer>> &
+            getPlayerListRef() const = 0;
+
+            /**
+                 * @brief Call a function on every player of the team
+                 * 
+                 * Iterates the list in place under the team lock instead of
+                 * copying it like getPlayerList(). The callback must not add
+                 * or remove players of this team.
+                 * 
+                 * @param callback Function called with each ServerPlayer
+                 */
+            template <typename Callback>
+            void forEachPlayer(Callback &&callback) const
+            {
+                auto lock = this->lockPlayerList();
+                for (const auto &player : this->getPlayerListRef()) {
+                    if (player)
+                        callback(*player);
+                }
+            }
         };
     }  // namespace game
 }  // namespace zappy
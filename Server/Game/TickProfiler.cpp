@@ -0,0 +1,230 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** TickProfiler
+*/
+
+#include "TickProfiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    /**
+     * @brief Name of each phase, indexed by TickPhase
+     */
+    constexpr std::string_view phaseNames[] = {
+        "inbox", "commands", "food", "respawn", "flush"};
+
+    static_assert(std::size(phaseNames) ==
+            static_cast<size_t>(zappy::game::TickPhase::COUNT),
+        "one name per phase");
+
+    /**
+     * @brief Write a duration in microseconds with one decimal
+     */
+    void writeUs(std::ostream &out, std::chrono::nanoseconds elapsed)
+    {
+        out << std::fixed << std::setprecision(1)
+            << static_cast<double>(elapsed.count()) / 1e3 << " us";
+    }
+}  // namespace
+
+void zappy::game::LatencyHistogram::record(std::chrono::nanoseconds elapsed)
+{
+    uint64_t value = static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 0));
+    uint64_t max = this->_max.load(std::memory_order_relaxed);
+
+    this->_buckets[_bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    this->_count.fetch_add(1, std::memory_order_relaxed);
+    this->_sum.fetch_add(value, std::memory_order_relaxed);
+    while (value > max &&
+        !this->_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+        ;
+}
+
+std::chrono::nanoseconds zappy::game::LatencyHistogram::total() const
+{
+    return std::chrono::nanoseconds(this->_sum.load(std::memory_order_relaxed));
+}
+
+std::chrono::nanoseconds zappy::game::LatencyHistogram::max() const
+{
+    return std::chrono::nanoseconds(this->_max.load(std::memory_order_relaxed));
+}
+
+std::chrono::nanoseconds zappy::game::LatencyHistogram::percentile(double quantile) const
+{
+    uint64_t count = this->count();
+
+    if (count == 0)
+        return std::chrono::nanoseconds::zero();
+    uint64_t rank = std::clamp<uint64_t>(static_cast<uint64_t>(
+        std::ceil(quantile * static_cast<double>(count))), 1, count);
+    uint64_t seen = 0;
+
+    for (size_t bucket = 0; bucket < bucketCount; bucket += 1) {
+        seen += this->_buckets[bucket].load(std::memory_order_relaxed);
+        if (seen >= rank)
+            return std::min(std::chrono::nanoseconds(_bucketTop(bucket)), this->max());
+    }
+    return this->max();
+}
+
+size_t zappy::game::LatencyHistogram::_bucketOf(uint64_t value)
+{
+    value = std::min(value, (uint64_t(1) << maxBits) - 1);
+    if (value < subCount)
+        return static_cast<size_t>(value);
+    unsigned msb = 63 - static_cast<unsigned>(__builtin_clzll(value));
+
+    return (msb - subBits + 1) * subCount +
+        static_cast<size_t>((value >> (msb - subBits)) & (subCount - 1));
+}
+
+uint64_t zappy::game::LatencyHistogram::_bucketTop(size_t bucket)
+{
+    if (bucket < subCount)
+        return bucket;
+    unsigned shift = static_cast<unsigned>(bucket / subCount) - 1;
+    uint64_t low = (subCount + bucket % subCount) << shift;
+
+    return low + (uint64_t(1) << shift) - 1;
+}
+
+void zappy::game::TickProfiler::beginIteration()
+{
+    this->_iterationStart = Clock::now();
+    this->_current.fill(Clock::duration::zero());
+}
+
+void zappy::game::TickProfiler::addPhase(TickPhase phase, Clock::duration elapsed)
+{
+    this->_current[static_cast<size_t>(phase)] += elapsed;
+}
+
+void zappy::game::TickProfiler::recordCommand(size_t command, Clock::duration elapsed)
+{
+    this->_commands[command].record(elapsed);
+
+    std::lock_guard<std::mutex> lock(this->_slowMutex);
+    if (this->_slowCount == slowestShown && elapsed <= this->_slowest.back().elapsed)
+        return;
+    size_t pos = std::min(this->_slowCount, slowestShown - 1);
+
+    while (pos > 0 && this->_slowest[pos - 1].elapsed < elapsed) {
+        this->_slowest[pos] = this->_slowest[pos - 1];
+        pos -= 1;
+    }
+    this->_slowest[pos] = {command, elapsed};
+    this->_slowCount = std::min(this->_slowCount + 1, slowestShown);
+}
+
+void zappy::game::TickProfiler::endIteration(uint32_t tick, Clock::duration budget)
+{
+    auto now = Clock::now();
+    auto elapsed = now - this->_iterationStart;
+    std::array<SlowCommand, slowestShown> slowest;
+    size_t slowCount = 0;
+
+    for (size_t phase = 0; phase < _phaseCount; phase += 1) {
+        if (this->_current[phase] != Clock::duration::zero())
+            this->_phases[phase].record(this->_current[phase]);
+    }
+    this->_iterations.record(elapsed);
+    {
+        std::lock_guard<std::mutex> lock(this->_slowMutex);
+
+        slowest = this->_slowest;
+        slowCount = this->_slowCount;
+        this->_slowCount = 0;
+    }
+    if (elapsed <= budget)
+        return;
+    this->_overruns += 1;
+    if (now - this->_lastReport < std::chrono::seconds(1)) {
+        this->_suppressed += 1;
+        return;
+    }
+    this->_lastReport = now;
+    this->_report(tick, elapsed, budget, slowest, slowCount);
+    this->_suppressed = 0;
+}
+
+void zappy::game::TickProfiler::_report(uint32_t tick, Clock::duration elapsed,
+    Clock::duration budget, const std::array<SlowCommand, slowestShown> &slowest,
+    size_t slowCount)
+{
+    std::array<size_t, _phaseCount> order;
+    std::ostringstream log;
+
+    for (size_t phase = 0; phase < _phaseCount; phase += 1)
+        order[phase] = phase;
+    std::stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+        return this->_current[lhs] > this->_current[rhs];
+    });
+    log << "Tick " << tick << " over budget: ";
+    writeUs(log, elapsed);
+    log << " for ";
+    writeUs(log, budget);
+    if (this->_suppressed > 0)
+        log << " (" << this->_suppressed << " more since the last report)";
+    log << "\n  phases:";
+    for (size_t phase : order) {
+        if (this->_current[phase] == Clock::duration::zero())
+            break;
+        log << (phase == order.front() ? " " : ", ") << phaseNames[phase] << ' ';
+        writeUs(log, this->_current[phase]);
+    }
+    if (slowCount > 0)
+        log << "\n  slowest commands:";
+    for (size_t idx = 0; idx < slowCount; idx += 1) {
+        log << (idx == 0 ? " " : ", ") << _commandName(slowest[idx].command) << ' ';
+        writeUs(log, slowest[idx].elapsed);
+    }
+    std::cout << log.str() << std::endl;
+}
+
+void zappy::game::TickProfiler::printSummary(std::ostream &out) const
+{
+    auto row = [&out](std::string_view name, const LatencyHistogram &histogram) {
+        if (histogram.count() == 0)
+            return;
+        auto us = [](std::chrono::nanoseconds elapsed) {
+            return static_cast<double>(elapsed.count()) / 1e3;
+        };
+
+        out << std::left << std::setw(14) << name << std::right
+            << std::setw(10) << histogram.count() << std::fixed
+            << std::setprecision(1) << std::setw(12)
+            << us(histogram.percentile(0.5)) << std::setw(12)
+            << us(histogram.percentile(0.99)) << std::setw(12)
+            << us(histogram.max()) << std::setw(12)
+            << us(histogram.total()) / 1e3 << '\n';
+    };
+
+    out << "Tick profile, " << this->_overruns << " loops over budget\n"
+        << std::left << std::setw(14) << "name" << std::right
+        << std::setw(10) << "count" << std::setw(12) << "p50 us"
+        << std::setw(12) << "p99 us" << std::setw(12) << "max us"
+        << std::setw(12) << "total ms" << '\n';
+    row("loop", this->_iterations);
+    for (size_t phase = 0; phase < _phaseCount; phase += 1)
+        row(phaseNames[phase], this->_phases[phase]);
+    for (size_t command = 0; command < commandCount; command += 1)
+        row(_commandName(command), this->_commands[command]);
+    out << std::flush;
+}
+
+std::string_view zappy::game::TickProfiler::_commandName(size_t command)
+{
+    constexpr size_t clientCount = static_cast<size_t>(ClientOpcode::UNKNOWN);
+
+    if (command < clientCount)
+        return clientCommandNames[command];
+    return guiCommandNames[command - clientCount];
+}
@@ -0,0 +1,298 @@
+/*
+** EPITECH PROJECT, 2025
+** Zappy
+** File description:
+** TickProfiler
+*/
+
+#pragma once
+
+#include "CommandTable.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+
+namespace zappy {
+    namespace game {
+        /**
+         * @brief Parts of a loop of the game thread
+         *
+         * Used as an index in the phase histograms, keep COUNT last.
+         */
+        enum class TickPhase : uint8_t {
+            INBOX,     ///< Lines popped from the client inboxes
+            COMMANDS,  ///< Commands dispatched, GUI commands run inline
+            FOOD,      ///< Food pass over the player table
+            RESPAWN,   ///< Resources scattered again
+            FLUSH,     ///< Output of the tick handed to the network, GUI events included
+            COUNT
+        };
+
+        /**
+         * @brief Histogram of durations with a bounded relative error
+         *
+         * Buckets follow the HDR layout: values below 16 ns get one bucket
+         * each, then every power of two is split into 16 buckets, so a
+         * recorded value is off by at most 1/16 of itself. Values above
+         * 2^40 ns (about 18 minutes) fall in the last bucket.
+         *
+         * Recording is lock-free and can happen from any thread.
+         */
+        class LatencyHistogram {
+           public:
+            /** @brief Bits of the value kept inside a power of two */
+            static constexpr unsigned subBits = 4;
+
+            /** @brief Buckets per power of two */
+            static constexpr size_t subCount = size_t(1) << subBits;
+
+            /** @brief Bits of the largest value told apart */
+            static constexpr unsigned maxBits = 40;
+
+            /** @brief Total number of buckets */
+            static constexpr size_t bucketCount = (maxBits - subBits + 1) * subCount;
+
+            /**
+             * @brief Record one duration
+             *
+             * @param elapsed Duration to record, negative ones count as 0
+             */
+            void record(std::chrono::nanoseconds elapsed);
+
+            /**
+             * @brief Get the number of recorded durations
+             *
+             * @return uint64_t Number of calls to record()
+             */
+            uint64_t count() const { return this->_count.load(std::memory_order_relaxed); }
+
+            /**
+             * @brief Get the sum of the recorded durations
+             *
+             * @return std::chrono::nanoseconds Exact sum
+             */
+            std::chrono::nanoseconds total() const;
+
+            /**
+             * @brief Get the longest recorded duration
+             *
+             * @return std::chrono::nanoseconds Exact maximum
+             */
+            std::chrono::nanoseconds max() const;
+
+            /**
+             * @brief Get a percentile of the recorded durations
+             *
+             * @param quantile Fraction of the durations, between 0 and 1
+             * @return std::chrono::nanoseconds Upper bound of the bucket
+             * holding the percentile, never above max()
+             */
+            std::chrono::nanoseconds percentile(double quantile) const;
+
+           private:
+            std::array<std::atomic<uint64_t>, bucketCount> _buckets{};  ///< Counts by bucket
+            std::atomic<uint64_t> _count = 0;  ///< Recorded durations
+            std::atomic<uint64_t> _sum = 0;    ///< Sum in nanoseconds
+            std::atomic<uint64_t> _max = 0;    ///< Maximum in nanoseconds
+
+            /**
+             * @brief Get the bucket of a value
+             *
+             * @param value Duration in nanoseconds
+             * @return size_t Index in _buckets
+             */
+            static size_t _bucketOf(uint64_t value);
+
+            /**
+             * @brief Get the largest value of a bucket
+             *
+             * @param bucket Index in _buckets
+             * @return uint64_t Duration in nanoseconds
+             */
+            static uint64_t _bucketTop(size_t bucket);
+        };
+
+        /**
+         * @brief Time spent in each part of the game loop and each command
+         *
+         * The game thread times its phases with ScopedPhase or addPhase()
+         * and closes each loop with endIteration(). Commands are recorded
+         * with recordCommand() from the thread running them: the game thread
+         * for GUI commands, their own thread for AI commands.
+         *
+         * When a loop takes longer than the budget, the watchdog logs its
+         * phases and the slowest commands recorded during it, at most once
+         * per second. printSummary() writes a table of every histogram.
+         */
+        class TickProfiler {
+           public:
+            /** @brief Clock of every measure */
+            using Clock = std::chrono::steady_clock;
+
+            /** @brief Number of slow commands logged by the watchdog */
+            static constexpr size_t slowestShown = 5;
+
+            /** @brief Number of command histograms, AI commands then GUI ones */
+            static constexpr size_t commandCount =
+                static_cast<size_t>(ClientOpcode::UNKNOWN) +
+                static_cast<size_t>(GuiOpcode::UNKNOWN);
+
+            /**
+             * @brief Times a phase from construction to destruction
+             */
+            class ScopedPhase {
+               public:
+                /**
+                 * @brief Start timing a phase
+                 *
+                 * @param profiler Profiler receiving the duration
+                 * @param phase Phase being timed
+                 */
+                ScopedPhase(TickProfiler &profiler, TickPhase phase)
+                    : _profiler(profiler), _phase(phase), _start(Clock::now()) {}
+
+                /**
+                 * @brief Add the elapsed time to the phase
+                 */
+                ~ScopedPhase() { this->_profiler.addPhase(this->_phase, Clock::now() - this->_start); }
+
+                ScopedPhase(const ScopedPhase &) = delete;
+                ScopedPhase &operator=(const ScopedPhase &) = delete;
+
+               private:
+                TickProfiler &_profiler;   ///< Profiler receiving the duration
+                TickPhase _phase;          ///< Phase being timed
+                Clock::time_point _start;  ///< Start of the phase
+            };
+
+            /**
+             * @brief Get the histogram index of an AI command
+             *
+             * @param opcode Known AI command
+             * @return size_t Index given to recordCommand()
+             */
+            static constexpr size_t command(ClientOpcode opcode) { return static_cast<size_t>(opcode); }
+
+            /**
+             * @brief Get the histogram index of a GUI command
+             *
+             * @param opcode Known GUI command
+             * @return size_t Index given to recordCommand()
+             */
+            static constexpr size_t command(GuiOpcode opcode)
+            {
+                return static_cast<size_t>(ClientOpcode::UNKNOWN) + static_cast<size_t>(opcode);
+            }
+
+            /**
+             * @brief Set the time a loop may take before the watchdog logs it
+             *
+             * @param budget Maximum duration of a loop, zero for one time unit
+             */
+            void setBudget(Clock::duration budget) { this->_budget = budget; }
+
+            /**
+             * @brief Get the budget of a loop
+             *
+             * @param tickInterval Current time unit
+             * @return Clock::duration The budget set, or the time unit
+             */
+            Clock::duration getBudget(Clock::duration tickInterval) const
+            {
+                return this->_budget == Clock::duration::zero() ? tickInterval : this->_budget;
+            }
+
+            /**
+             * @brief Start a loop of the game thread
+             */
+            void beginIteration();
+
+            /**
+             * @brief Add time to a phase of the current loop
+             *
+             * Game thread only. A phase may be added several times per loop,
+             * the histogram receives the sum when the loop ends.
+             *
+             * @param phase Phase of the time
+             * @param elapsed Time spent
+             */
+            void addPhase(TickPhase phase, Clock::duration elapsed);
+
+            /**
+             * @brief Record the execution time of a command
+             *
+             * @param command Index from command()
+             * @param elapsed Time spent running it
+             */
+            void recordCommand(size_t command, Clock::duration elapsed);
+
+            /**
+             * @brief End a loop, record its phases and check its budget
+             *
+             * @param tick Game tick of the loop, for the log
+             * @param budget Maximum duration of the loop
+             */
+            void endIteration(uint32_t tick, Clock::duration budget);
+
+            /**
+             * @brief Write a table of every histogram that recorded something
+             *
+             * @param out Stream receiving the table
+             */
+            void printSummary(std::ostream &out) const;
+
+           private:
+            /**
+             * @brief A command of the slowest ones of the current loop
+             */
+            struct SlowCommand {
+                size_t command = 0;                           ///< Index from command()
+                Clock::duration elapsed = Clock::duration::zero();  ///< Time spent
+            };
+
+            static constexpr size_t _phaseCount = static_cast<size_t>(TickPhase::COUNT);
+
+            Clock::duration _budget = Clock::duration::zero();  ///< Set by setBudget()
+
+            std::array<LatencyHistogram, _phaseCount> _phases;  ///< One histogram per phase
+            std::array<LatencyHistogram, commandCount> _commands;  ///< One histogram per command
+            LatencyHistogram _iterations;  ///< Whole loops, sleep excluded
+
+            Clock::time_point _iterationStart;  ///< Start of the current loop
+            std::array<Clock::duration, _phaseCount> _current{};  ///< Phases of the current loop
+
+            std::mutex _slowMutex;  ///< Guards the two members below
+            std::array<SlowCommand, slowestShown> _slowest{};  ///< Slowest first
+            size_t _slowCount = 0;  ///< Used entries of _slowest
+
+            Clock::time_point _lastReport;  ///< Last log of the watchdog
+            uint64_t _overruns = 0;         ///< Loops over budget
+            uint64_t _suppressed = 0;       ///< Overruns not logged since _lastReport
+
+            /**
+             * @brief Get the name of a command histogram
+             *
+             * @param command Index from command()
+             * @return std::string_view Protocol name of the command
+             */
+            static std::string_view _commandName(size_t command);
+
+            /**
+             * @brief Log a loop over budget
+             *
+             * @param tick Game tick of the loop
+             * @param elapsed Duration of the loop
+             * @param budget Budget of the loop
+             * @param slowest Slowest commands of the loop
+             * @param slowCount Used entries of slowest
+             */
+            void _report(uint32_t tick, Clock::duration elapsed, Clock::duration budget,
+                const std::array<SlowCommand, slowestShown> &slowest, size_t slowCount);
+        };
+    }  // namespace game
+}  // namespace zappy
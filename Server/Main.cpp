@@ -5,13 +5,61 @@
 ** main
 */
 
+#include "Replay.hpp"
+#include "RoomHost.hpp"
 #include "Server.hpp"
+#include <cstdlib>
 
 static void displayHelp()
 {
     std::cout << "USAGE: -p port -x width -y height -n name1 name2 ... -c "
-                 "clientNB -f freq"
+                 "clientNB -f freq [-s seed] [-N poll|uring] [-b backlog] [-q kib] "
+                 "[-B budget_us] [-e budget_us] "
+                 "[-l snapshot] [-w snapshot] [-j journal]"
               << std::endl;
+    std::cout << "       -R journal [-f freq]" << std::endl;
+    std::cout << "       -r rooms" << std::endl;
+}
+
+static int runReplay(int argc, char const *argv[])
+{
+    std::string path;
+    int freq = zappy::noValue;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "-R")
+            path = argv[i + 1];
+        else if (flag == "-f")
+            freq = std::atoi(argv[i + 1]);
+        else
+            throw zappy::error::InvalidArg("Unknown replay flag " + flag);
+    }
+    if (path.empty())
+        throw zappy::error::InvalidArg("Missing journal after -R");
+    zappy::server::Replay replay(path, freq);
+
+    replay.run();
+    return OK;
+}
+
+static int runRooms(int argc, char const *argv[])
+{
+    if (argc != 3 || std::string(argv[1]) != "-r")
+        throw zappy::error::InvalidArg("-r takes a room file and no other flag");
+    zappy::server::RoomHost host(argv[2]);
+
+    host.run();
+    return OK;
+}
+
+static bool hasFlag(int argc, char const *argv[], const std::string &flag)
+{
+    for (int i = 1; i < argc; i += 1) {
+        if (flag == argv[i])
+            return true;
+    }
+    return false;
 }
 
 static bool checkArgs(int argc)
@@ -25,6 +73,22 @@ static bool checkArgs(int argc)
 
 int main(int argc, char const *argv[])
 {
+    if (hasFlag(argc, argv, "-r")) {
+        try {
+            return runRooms(argc, argv);
+        } catch (const zappy::error::Error &e) {
+            std::cerr << " Error: " << e.what() << std::endl;
+            return KO;
+        }
+    }
+    if (hasFlag(argc, argv, "-R")) {
+        try {
+            return runReplay(argc, argv);
+        } catch (const zappy::error::Error &e) {
+            std::cerr << " Error: " << e.what() << std::endl;
+            return KO;
+        }
+    }
     if (checkArgs(argc) == false)
         return KO;
     try {
@@ -0,0 +1,94 @@
+//
+// EPITECH PROJECT, 2025
+// INetworkBackend
+// File description:
+// Interface of the server network backends
+//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zappy {
+
+    namespace server {
+
+        /**
+         * @struct NetworkEvent
+         * @brief Something that happened on a socket during a wait.
+         */
+        struct NetworkEvent {
+            /**
+             * @brief Kind of event.
+             */
+            enum class Kind {
+                ACCEPT,  ///< A new client is connected on fd
+                DATA,    ///< data was received from fd
+                CLOSED,  ///< fd was closed by the client or failed
+                SLOW,    ///< fd went over its output limit, output is dropped
+                RESUMED  ///< fd caught up after SLOW, output is sent again
+            };
+
+            Kind kind;         ///< Kind of event
+            int fd;            ///< Client socket
+            std::string data;  ///< Received bytes, for DATA only
+        };
+
+        /**
+         * @class INetworkBackend
+         * @brief Waits for the client sockets and sends to them.
+         *
+         * A backend owns every client socket it accepted: the server asks
+         * it to close them. All methods are called from the network thread.
+         *
+         * Output waits in one OutputQueue per client, bounded by the
+         * OutputLimits given to the backend: no send ever blocks.
+         */
+        class INetworkBackend {
+           public:
+            virtual ~INetworkBackend() = default;
+
+            /**
+             * @brief Wait for network activity.
+             * @param events Filled with what happened, cleared first.
+             * @param timeoutMs Longest wait in milliseconds.
+             */
+            virtual void wait(
+                std::vector<NetworkEvent> &events, int timeoutMs) = 0;
+
+            /**
+             * @brief Send data to a client, after what was already sent to it.
+             * @param fd Client socket.
+             * @param data Bytes to send.
+             */
+            virtual void send(int fd, std::string_view data) = 0;
+
+            /**
+             * @brief Send a buffer shared by several clients.
+             *
+             * Like send(), but the buffer is referenced by the queue of the
+             * client instead of copied whenever nothing else is queued.
+             * @param fd Client socket.
+             * @param data Bytes to send, never modified afterwards.
+             */
+            virtual void sendShared(
+                int fd, std::shared_ptr<const std::string> data) = 0;
+
+            /**
+             * @brief Stop watching a client and close its socket.
+             * @param fd Client socket.
+             */
+            virtual void close(int fd) = 0;
+
+            /**
+             * @brief Get the name of the backend, as given to -N.
+             * @return The backend name.
+             */
+            virtual const char *getName() const = 0;
+        };
+
+    }  // namespace server
+}  // namespace zappy
@@ -0,0 +1,43 @@
+//
+// EPITECH PROJECT, 2025
+// NetworkStats
+// File description:
+// Counters of the network layer
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace zappy {
+    namespace server {
+
+        /**
+         * @brief Number of network system calls made by the server
+         *
+         * Counts waits, accepts, reads and sends, whatever the backend.
+         */
+        inline std::atomic<size_t> networkSyscalls{0};
+
+        /**
+         * @brief Number of client lines accepted into the inboxes
+         */
+        inline std::atomic<size_t> clientLines{0};
+
+        /**
+         * @brief Bytes waiting in the output queues of the backends
+         */
+        inline std::atomic<size_t> queuedBytes{0};
+
+        /**
+         * @brief Highest value reached by queuedBytes
+         */
+        inline std::atomic<size_t> peakQueuedBytes{0};
+
+        /**
+         * @brief Number of times a client went over its output limit
+         */
+        inline std::atomic<size_t> slowConsumers{0};
+    }  // namespace server
+}  // namespace zappy
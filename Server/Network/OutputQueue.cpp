@@ -0,0 +1,136 @@
+//
+// EPITECH PROJECT, 2025
+// OutputQueue
+// File description:
+// Bounded output queue of a client connection
+//
+
+#include "OutputQueue.hpp"
+#include "NetworkStats.hpp"
+
+zappy::server::OutputQueue::OutputQueue(OutputQueue &&other) noexcept
+    : _pending(std::move(other._pending)), _current(std::move(other._current)),
+      _shared(std::move(other._shared)), _sent(other._sent), _dropping(other._dropping),
+      _progressed(other._progressed)
+{
+    other._pending.clear();
+    other._current.clear();
+    other._shared.reset();
+    other._sent = 0;
+}
+
+zappy::server::OutputQueue::~OutputQueue()
+{
+    this->clear();
+}
+
+bool zappy::server::OutputQueue::_accept(size_t size, const OutputLimits &limits)
+{
+    size_t before = this->size();
+
+    if (before + size <= limits.high ||
+        (before == 0 && size <= limits.high * OutputLimits::burstFactor))
+        return true;
+    this->dropPending();
+    this->_dropping = true;
+    this->_progressed = this->size() == 0;
+    slowConsumers.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+zappy::server::OutputQueue::Append zappy::server::OutputQueue::append(
+    std::string_view data, const OutputLimits &limits)
+{
+    size_t before = this->size();
+
+    if (this->_dropping)
+        return Append::DROPPED;
+    if (!this->_accept(data.size(), limits))
+        return Append::OVERFLOW;
+    this->_pending.append(data);
+    this->_account(before);
+    return Append::QUEUED;
+}
+
+zappy::server::OutputQueue::Append zappy::server::OutputQueue::appendShared(
+    std::shared_ptr<const std::string> data, const OutputLimits &limits)
+{
+    if (this->size() > 0 || this->_dropping)
+        return this->append(*data, limits);
+    if (!this->_accept(data->size(), limits))
+        return Append::OVERFLOW;
+    this->_current.clear();
+    this->_sent = 0;
+    this->_shared = std::move(data);
+    this->_account(0);
+    return Append::QUEUED;
+}
+
+std::string_view zappy::server::OutputQueue::next()
+{
+    if (this->_sent == this->_chunk().size() && !this->_pending.empty()) {
+        this->_shared.reset();
+        this->_current.swap(this->_pending);
+        this->_pending.clear();
+        this->_sent = 0;
+    }
+    return this->_chunk().substr(this->_sent);
+}
+
+void zappy::server::OutputQueue::consume(size_t count)
+{
+    size_t before = this->size();
+
+    this->_sent += count;
+    this->_progressed = true;
+    if (this->_sent >= this->_chunk().size()) {
+        this->_shared.reset();
+        this->_current.clear();
+        this->_sent = 0;
+    }
+    this->_account(before);
+}
+
+bool zappy::server::OutputQueue::resume(const OutputLimits &limits)
+{
+    if (!this->_dropping || !this->_progressed || this->size() > limits.low)
+        return false;
+    this->_dropping = false;
+    return true;
+}
+
+void zappy::server::OutputQueue::clear()
+{
+    size_t before = this->size();
+
+    this->_pending.clear();
+    this->_current.clear();
+    this->_shared.reset();
+    this->_sent = 0;
+    this->_account(before);
+}
+
+void zappy::server::OutputQueue::dropPending()
+{
+    size_t before = this->size();
+
+    this->_pending.clear();
+    this->_account(before);
+}
+
+void zappy::server::OutputQueue::_account(size_t before) const
+{
+    size_t after = this->size();
+
+    if (after < before) {
+        queuedBytes.fetch_sub(before - after, std::memory_order_relaxed);
+        return;
+    }
+    size_t total =
+        queuedBytes.fetch_add(after - before, std::memory_order_relaxed) +
+        after - before;
+    size_t peak = peakQueuedBytes.load(std::memory_order_relaxed);
+    while (total > peak &&
+        !peakQueuedBytes.compare_exchange_weak(peak, total, std::memory_order_relaxed))
+        ;
+}
@@ -0,0 +1,164 @@
+//
+// EPITECH PROJECT, 2025
+// OutputQueue
+// File description:
+// Bounded output queue of a client connection
+//
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace zappy {
+
+    namespace server {
+
+        /**
+         * @struct OutputLimits
+         * @brief Watermarks of the output queue of every client.
+         */
+        struct OutputLimits {
+            /// A single append to an empty queue may reach this many times high
+            static constexpr size_t burstFactor = 16;
+
+            size_t high = 4 << 20;   ///< Bytes above which output is dropped
+            size_t low = 1 << 20;    ///< Bytes below which a dropping client resumes
+        };
+
+        /**
+         * @class OutputQueue
+         * @brief Bytes waiting to be sent to one client.
+         *
+         * The queue holds whole messages. Appending data that would go over
+         * the high watermark drops everything not handed to the kernel yet,
+         * then every later append, until the client reads enough to go
+         * under the low watermark, having received part of what was
+         * queued. A queue that overflows with nothing in the kernel may
+         * resume at once. A single append to an empty queue may go up to
+         * OutputLimits::burstFactor times the high watermark, so a GUI
+         * snapshot larger than the limit can still be sent.
+         *
+         * The chunk returned by next() stays valid, and is never dropped,
+         * until consume() reaches its end or clear() is called. A shared
+         * buffer appended to an empty queue becomes the chunk itself, so a
+         * buffer sent to many clients is never copied.
+         */
+        class OutputQueue {
+           public:
+            /**
+             * @brief Result of an append.
+             */
+            enum class Append {
+                QUEUED,    ///< Data is queued
+                OVERFLOW,  ///< The queue went over the limit, it now drops
+                DROPPED    ///< The queue was already dropping
+            };
+
+            OutputQueue() = default;
+            OutputQueue(const OutputQueue &) = delete;
+            OutputQueue &operator=(const OutputQueue &) = delete;
+            OutputQueue(OutputQueue &&other) noexcept;
+            OutputQueue &operator=(OutputQueue &&) = delete;
+            ~OutputQueue();
+
+            /**
+             * @brief Queue data after what is already queued.
+             * @param data Bytes to send.
+             * @param limits Watermarks of the queue.
+             * @return What happened to the data.
+             */
+            Append append(std::string_view data, const OutputLimits &limits);
+
+            /**
+             * @brief Queue a buffer shared with other queues.
+             *
+             * Same rules as append(). The buffer is referenced, not copied,
+             * when nothing else is queued.
+             * @param data Bytes to send, never modified while referenced.
+             * @param limits Watermarks of the queue.
+             * @return What happened to the data.
+             */
+            Append appendShared(std::shared_ptr<const std::string> data,
+                const OutputLimits &limits);
+
+            /**
+             * @brief Get the bytes to send next.
+             * @return The unsent part of the current chunk, empty if none.
+             */
+            std::string_view next();
+
+            /**
+             * @brief Mark bytes of the current chunk as sent.
+             * @param count Number of bytes the kernel accepted.
+             */
+            void consume(size_t count);
+
+            /**
+             * @brief Leave the dropping state once the client caught up.
+             * @param limits Watermarks of the queue.
+             * @return true only on the call that leaves the dropping state.
+             */
+            bool resume(const OutputLimits &limits);
+
+            /**
+             * @brief Drop every queued byte, the current chunk included.
+             *
+             * Only call this when the current chunk is not in the kernel.
+             */
+            void clear();
+
+            /**
+             * @brief Drop the bytes not handed to the kernel yet.
+             */
+            void dropPending();
+
+            /**
+             * @brief Get the number of bytes not sent yet.
+             * @return The queued size.
+             */
+            size_t size() const { return this->_pending.size() + this->_chunk().size() - this->_sent; }
+
+            /**
+             * @brief Tell whether output is being dropped.
+             * @return true between an overflow and the resume.
+             */
+            bool isDropping() const { return this->_dropping; }
+
+           private:
+            std::string _pending;    ///< Bytes after the current chunk
+            std::string _current;    ///< Chunk being sent, unless _shared is set
+            std::shared_ptr<const std::string> _shared;  ///< Shared chunk being sent
+            size_t _sent = 0;        ///< Bytes of _current already sent
+            bool _dropping = false;  ///< Over the limit, waiting to resume
+            bool _progressed = false;  ///< Bytes were sent since the overflow, or none were in flight
+
+            /**
+             * @brief Get the chunk being sent.
+             * @return The shared chunk if any, else _current.
+             */
+            std::string_view _chunk() const
+            {
+                return this->_shared ? std::string_view(*this->_shared)
+                                     : std::string_view(this->_current);
+            }
+
+            /**
+             * @brief Tell whether data may be queued.
+             * @param size Number of bytes to add.
+             * @param limits Watermarks of the queue.
+             * @return false after switching to the dropping state.
+             */
+            bool _accept(size_t size, const OutputLimits &limits);
+
+            /**
+             * @brief Update queuedBytes and peakQueuedBytes.
+             * @param before Size of the queue before the change.
+             */
+            void _account(size_t before) const;
+        };
+
+    }  // namespace server
+}  // namespace zappy
@@ -0,0 +1,188 @@
+//
+// EPITECH PROJECT, 2025
+// PollBackend
+// File description:
+// Portable poll() network backend
+//
+
+#include "PollBackend.hpp"
+#include "Error.hpp"
+#include "NetworkStats.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <sys/socket.h>
+#include <unistd.h>
+
+zappy::server::PollBackend::PollBackend(int listenSocket, const OutputLimits &limits)
+    : _listenSocket(listenSocket), _limits(limits)
+{
+    this->_fds.push_back({listenSocket, POLLIN, 0});
+}
+
+zappy::server::PollBackend::~PollBackend()
+{
+    for (auto &queue : this->_queues)
+        ::close(queue.first);
+}
+
+void zappy::server::PollBackend::wait(
+    std::vector<NetworkEvent> &events, int timeoutMs)
+{
+    events.clear();
+    this->_drainOutputs();
+    for (auto &pfd : this->_fds) {
+        auto queue = this->_queues.find(pfd.fd);
+        if (queue != this->_queues.end())
+            pfd.events = queue->second.size() > 0 ? POLLIN | POLLOUT : POLLIN;
+    }
+    networkSyscalls.fetch_add(1, std::memory_order_relaxed);
+    if (poll(this->_fds.data(), this->_fds.size(), timeoutMs) < 0) {
+        if (errno == EINTR)
+            return;
+        throw error::SocketError("Poll failed");
+    }
+    for (size_t i = 0; i < this->_fds.size(); i += 1) {
+        auto pfd = this->_fds[i];
+
+        if (pfd.revents == 0)
+            continue;
+        if (pfd.fd == this->_listenSocket) {
+            this->_acceptAll(events);
+            continue;
+        }
+        if (pfd.revents & POLLOUT) {
+            auto queue = this->_queues.find(pfd.fd);
+            if (queue != this->_queues.end())
+                this->_write(pfd.fd, queue->second);
+        }
+        if (pfd.revents & (POLLIN | POLLHUP | POLLERR))
+            this->_read(pfd.fd, events);
+    }
+    events.insert(events.end(), this->_notices.begin(), this->_notices.end());
+    this->_notices.clear();
+}
+
+/**
+ * @brief Accept every pending connection
+ *
+ * The listening socket is non-blocking, so a burst of connections is
+ * emptied from the kernel queue in one wait instead of one per poll().
+ */
+void zappy::server::PollBackend::_acceptAll(std::vector<NetworkEvent> &events)
+{
+    while (true) {
+        int clientSocket = accept4(this->_listenSocket, nullptr, nullptr,
+            SOCK_NONBLOCK | SOCK_CLOEXEC);
+        networkSyscalls.fetch_add(1, std::memory_order_relaxed);
+        if (clientSocket < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            return;
+        }
+        this->_fds.push_back({clientSocket, POLLIN, 0});
+        this->_queues.emplace(clientSocket, OutputQueue());
+        events.push_back({NetworkEvent::Kind::ACCEPT, clientSocket, {}});
+    }
+}
+
+void zappy::server::PollBackend::_read(int fd, std::vector<NetworkEvent> &events)
+{
+    constexpr short buffSize = 1024;
+    char buffer[buffSize];
+
+    networkSyscalls.fetch_add(1, std::memory_order_relaxed);
+    auto readValue = read(fd, buffer, sizeof(buffer));
+    if (readValue < 0 && (errno == EAGAIN || errno == EINTR))
+        return;
+    if (readValue <= 0)
+        events.push_back({NetworkEvent::Kind::CLOSED, fd, {}});
+    else
+        events.push_back({NetworkEvent::Kind::DATA, fd,
+            std::string(buffer, readValue)});
+}
+
+void zappy::server::PollBackend::schedule(
+    int socket, std::shared_ptr<ClientOutput> output)
+{
+    std::lock_guard<std::mutex> lock(this->_scheduleMutex);
+
+    this->_scheduled.emplace_back(socket, std::move(output));
+}
+
+void zappy::server::PollBackend::_drainOutputs()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_scheduleMutex);
+        this->_draining.swap(this->_scheduled);
+    }
+    for (auto &[fd, output] : this->_draining) {
+        std::lock_guard<std::mutex> lock(output->mutex);
+
+        output->scheduled = false;
+        this->_queue(fd, output->buffer);
+        output->buffer.clear();
+    }
+    this->_draining.clear();
+}
+
+void zappy::server::PollBackend::send(int fd, std::string_view data)
+{
+    this->_queue(fd, data);
+}
+
+void zappy::server::PollBackend::sendShared(
+    int fd, std::shared_ptr<const std::string> data)
+{
+    auto queue = this->_queues.find(fd);
+
+    if (queue == this->_queues.end())
+        return;
+    this->_queued(fd, queue->second,
+        queue->second.appendShared(std::move(data), this->_limits));
+}
+
+void zappy::server::PollBackend::_queue(int fd, std::string_view data)
+{
+    auto queue = this->_queues.find(fd);
+
+    if (queue == this->_queues.end())
+        return;
+    this->_queued(fd, queue->second, queue->second.append(data, this->_limits));
+}
+
+void zappy::server::PollBackend::_queued(
+    int fd, OutputQueue &queue, OutputQueue::Append result)
+{
+    if (result == OutputQueue::Append::OVERFLOW)
+        this->_notices.push_back({NetworkEvent::Kind::SLOW, fd, {}});
+    this->_write(fd, queue);
+}
+
+void zappy::server::PollBackend::_write(int fd, OutputQueue &queue)
+{
+    for (auto chunk = queue.next(); !chunk.empty(); chunk = queue.next()) {
+        ssize_t bytesSent = ::send(fd, chunk.data(), chunk.size(), MSG_NOSIGNAL);
+        networkSyscalls.fetch_add(1, std::memory_order_relaxed);
+        if (bytesSent < 0 && (errno == EAGAIN || errno == EINTR))
+            break;
+        if (bytesSent <= 0) {
+            queue.clear();
+            break;
+        }
+        queue.consume(static_cast<size_t>(bytesSent));
+    }
+    if (queue.resume(this->_limits))
+        this->_notices.push_back({NetworkEvent::Kind::RESUMED, fd, {}});
+}
+
+void zappy::server::PollBackend::close(int fd)
+{
+    auto it = std::find_if(this->_fds.begin(), this->_fds.end(),
+        [fd](const pollfd &pfd) { return pfd.fd == fd; });
+
+    if (it == this->_fds.end())
+        return;
+    this->_fds.erase(it);
+    this->_queues.erase(fd);
+    ::close(fd);
+}
@@ -0,0 +1,117 @@
+//
+// EPITECH PROJECT, 2025
+// PollBackend
+// File description:
+// Portable poll() network backend
+//
+
+#pragma once
+
+#include "ClientOutput.hpp"
+#include "INetworkBackend.hpp"
+#include "OutputQueue.hpp"
+#include <memory>
+#include <mutex>
+#include <sys/poll.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace zappy {
+
+    namespace server {
+
+        /**
+         * @class PollBackend
+         * @brief Portable backend built on poll().
+         *
+         * One read per readable socket and per wait, and every pending
+         * connection accepted. Client sockets are non-blocking: output is
+         * written as far as the kernel takes it, the rest waits in the
+         * queue of the client until poll() reports the socket writable.
+         *
+         * The backend is the IOutputSink of the clients, their buffers are
+         * moved to the queues at the start of each wait.
+         */
+        class PollBackend : public INetworkBackend, public IOutputSink {
+           public:
+            /**
+             * @brief Watch the listening socket.
+             * @param listenSocket Socket accepting the clients.
+             * @param limits Watermarks of the client output queues.
+             */
+            PollBackend(int listenSocket, const OutputLimits &limits);
+
+            /**
+             * @brief Close every client socket.
+             */
+            ~PollBackend() override;
+
+            PollBackend(const PollBackend &) = delete;
+            PollBackend &operator=(const PollBackend &) = delete;
+
+            void wait(std::vector<NetworkEvent> &events, int timeoutMs) override;
+            void send(int fd, std::string_view data) override;
+            void sendShared(int fd, std::shared_ptr<const std::string> data) override;
+            void close(int fd) override;
+            const char *getName() const override { return "poll"; }
+
+            void schedule(int socket, std::shared_ptr<ClientOutput> output) override;
+
+           private:
+            int _listenSocket;            ///< Socket accepting the clients.
+            OutputLimits _limits;         ///< Watermarks of the queues.
+            std::vector<pollfd> _fds;     ///< Listening socket, then clients.
+            std::unordered_map<int, OutputQueue> _queues;  ///< By socket.
+            std::vector<NetworkEvent> _notices;  ///< SLOW and RESUMED events.
+
+            std::mutex _scheduleMutex;  ///< Guards _scheduled.
+            std::vector<std::pair<int, std::shared_ptr<ClientOutput>>>
+                _scheduled;  ///< Outputs queued by Client::flushMessages.
+            std::vector<std::pair<int, std::shared_ptr<ClientOutput>>>
+                _draining;   ///< Outputs being moved to their queue.
+
+            /**
+             * @brief Accept connections until the queue is empty.
+             * @param events Receives one ACCEPT per new client.
+             */
+            void _acceptAll(std::vector<NetworkEvent> &events);
+
+            /**
+             * @brief Move the buffers queued by the clients to their queue.
+             */
+            void _drainOutputs();
+
+            /**
+             * @brief Queue data for a client and write what the socket takes.
+             * @param fd Client socket.
+             * @param data Bytes to send.
+             */
+            void _queue(int fd, std::string_view data);
+
+            /**
+             * @brief Write what the socket takes after an append.
+             * @param fd Client socket.
+             * @param queue Queue of the client.
+             * @param result Result of the append.
+             */
+            void _queued(int fd, OutputQueue &queue, OutputQueue::Append result);
+
+            /**
+             * @brief Write the queue of a client until it is empty or the
+             * socket is full.
+             * @param fd Client socket.
+             * @param queue Queue of the client.
+             */
+            void _write(int fd, OutputQueue &queue);
+
+            /**
+             * @brief Read from a readable client socket.
+             * @param fd Client socket.
+             * @param events Receives DATA or CLOSED.
+             */
+            void _read(int fd, std::vector<NetworkEvent> &events);
+        };
+
+    }  // namespace server
+}  // namespace zappy
@@ -12,15 +12,16 @@
 #include <iostream>
 #include <memory>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <string>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
 
-zappy::server::SocketServer::SocketServer(int port, std::uint8_t nbClients)
+zappy::server::SocketServer::SocketServer(int port, int backlog)
 {
     this->_port = port;
-    this->_nbClients = nbClients;
+    this->_backlog = backlog;
     if (this->_port <= 0)
         throw error::SocketError("Wrong Port for socket");
 
@@ -37,10 +38,17 @@ zappy::server::SocketServer::SocketServer(int port, std::uint8_t nbClients)
 
 void zappy::server::SocketServer::_initSocket()
 {
-    this->_socket = socket(AF_INET, SOCK_STREAM, 0);
+    this->_socket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
     if (this->_socket < 0)
         throw error::SocketError("Socket failed");
 
+    // Inherited by the accepted sockets: output is already coalesced per
+    // tick, Nagle would only delay it
+    int noDelay = 1;
+    if (setsockopt(this->_socket, IPPROTO_TCP, TCP_NODELAY, &noDelay,
+            sizeof(noDelay)) < 0)
+        throw error::SocketError("Unable to set TCP_NODELAY");
+
     if (bind(this->_socket, (struct sockaddr *)this->_address.get(),
             sizeof(struct sockaddr_in)) < 0) {
         if (errno == EADDRINUSE)
@@ -48,7 +56,7 @@ void zappy::server::SocketServer::_initSocket()
         throw error::SocketError("Bind failed");
     }
 
-    if (listen(this->_socket, this->_nbClients) < 0)
+    if (listen(this->_socket, this->_backlog) < 0)
         throw error::SocketError("Listen failed");
 }
 
@@ -106,26 +114,3 @@ std::string zappy::server::SocketServer::getServerInformation()
     }
     return str;
 }
-
-void zappy::server::SocketServer::getData(std::vector<struct pollfd> &fds) const
-{
-    int poll_c = poll(fds.data(), fds.size(), 0);
-    if (poll_c < 0)
-        throw error::SocketError("Poll failed");
-}
-
-pollfd zappy::server::SocketServer::acceptConnection()
-{
-    sockaddr_in clientAddr{};
-    socklen_t clientLen = sizeof(clientAddr);
-    int clientSocket =
-        accept(this->_socket, (sockaddr *)&clientAddr, &clientLen);
-
-    if (clientSocket < 0)
-        throw error::SocketError("Accept failed");
-
-    pollfd fd = {clientSocket, POLLIN, 0};
-
-    this->sendMessage(clientSocket, "WELCOME\n");
-    return fd;
-}
@@ -35,18 +35,19 @@ namespace zappy {
 
             /**
      * @brief Constructs a new Socket object.
-     * @param ip The server IP address.
+     *
+     * The listening socket is non-blocking: a backend accepts until
+     * EAGAIN each time it becomes readable.
      * @param port The server port number.
+     * @param backlog Length of the queue of connections not accepted yet.
      */
-            explicit SocketServer(int port, const std::uint8_t nbClients);
+            explicit SocketServer(int port, int backlog);
 
             /**
      * @brief Destroys the Socket object and closes the connection if open.
      */
             ~SocketServer();
 
-            pollfd acceptConnection();
-
             /**
      * @brief Creates the connection to the server.
      */
@@ -69,11 +70,10 @@ namespace zappy {
      * @return The socket descriptor as an integer.
      */
             int getSocket() const;
-            void getData(std::vector<struct pollfd> &fds) const;
 
            private:
             int _socket;  ///< File descriptor for the socket.
-            uint8_t _nbClients;
+            int _backlog; ///< Pending connections queue length.
             int _port;           ///< Port number.
             socklen_t _addrlen;  ///< Length of the socket address.
             std::unique_ptr<struct sockaddr_in> _address =
@@ -0,0 +1,484 @@
+//
+// EPITECH PROJECT, 2025
+// UringBackend
+// File description:
+// io_uring network backend
+//
+
+#include "UringBackend.hpp"
+#include "Error.hpp"
+#include "NetworkStats.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>)
+    #include <linux/io_uring.h>
+#endif
+
+#if defined(IORING_RECV_MULTISHOT) && defined(IORING_ACCEPT_MULTISHOT)
+
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+
+namespace {
+    constexpr int opShift = 56;
+    constexpr uint64_t idMask = (uint64_t(1) << opShift) - 1;
+
+    int ioUringSetup(unsigned entries, io_uring_params *params)
+    {
+        return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int ioUringEnter(int ring, unsigned toSubmit, unsigned minComplete,
+        unsigned flags, const void *arg, size_t argSize)
+    {
+        return static_cast<int>(syscall(__NR_io_uring_enter, ring, toSubmit,
+            minComplete, flags, arg, argSize));
+    }
+
+    int ioUringRegister(int ring, unsigned opcode, void *arg, unsigned count)
+    {
+        return static_cast<int>(
+            syscall(__NR_io_uring_register, ring, opcode, arg, count));
+    }
+
+    std::string systemError(const std::string &what)
+    {
+        return what + ": " + std::strerror(errno);
+    }
+}  // namespace
+
+zappy::server::UringBackend::UringBackend(int listenSocket, const OutputLimits &limits)
+    : _listenSocket(listenSocket), _limits(limits)
+{
+    try {
+        this->_setupRing();
+        this->_setupBuffers();
+    } catch (...) {
+        this->_release();
+        throw;
+    }
+    this->_armAccept();
+}
+
+zappy::server::UringBackend::~UringBackend()
+{
+    for (auto &connection : this->_idByFd)
+        ::close(connection.first);
+    this->_release();
+}
+
+void zappy::server::UringBackend::_setupRing()
+{
+    io_uring_params params{};
+
+    this->_ring = ioUringSetup(ringEntries, &params);
+    if (this->_ring < 0)
+        throw error::SocketError(systemError("io_uring_setup failed"));
+    if (!(params.features & IORING_FEAT_EXT_ARG))
+        throw error::SocketError("io_uring has no timed wait (kernel < 5.11)");
+
+    this->_sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    this->_cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        this->_sqMapSize = this->_cqMapSize =
+            std::max(this->_sqMapSize, this->_cqMapSize);
+    this->_sqMap = mmap(nullptr, this->_sqMapSize, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, this->_ring, IORING_OFF_SQ_RING);
+    if (this->_sqMap == MAP_FAILED) {
+        this->_sqMap = nullptr;
+        throw error::SocketError(systemError("io_uring mmap failed"));
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        this->_cqMap = this->_sqMap;
+    } else {
+        this->_cqMap = mmap(nullptr, this->_cqMapSize, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, this->_ring, IORING_OFF_CQ_RING);
+        if (this->_cqMap == MAP_FAILED) {
+            this->_cqMap = nullptr;
+            throw error::SocketError(systemError("io_uring mmap failed"));
+        }
+    }
+    this->_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = mmap(nullptr, this->_sqesSize, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, this->_ring, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+        throw error::SocketError(systemError("io_uring mmap failed"));
+    this->_sqes = static_cast<io_uring_sqe *>(sqes);
+
+    auto *sq = static_cast<char *>(this->_sqMap);
+    auto *cq = static_cast<char *>(this->_cqMap);
+    this->_sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    this->_sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    this->_sqMask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    this->_sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    this->_sqEntries = params.sq_entries;
+    this->_sqLocalTail = *this->_sqTail;
+    this->_cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    this->_cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    this->_cqMask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    this->_cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+}
+
+/**
+ * @brief Register the ring of provided receive buffers
+ *
+ * Needs Linux 5.19. The ring memory is shared with the kernel, a buffer
+ * goes back to it as soon as its bytes are copied into an event.
+ */
+void zappy::server::UringBackend::_setupBuffers()
+{
+    io_uring_buf_reg registration{};
+
+    this->_bufRingSize = bufferCount * sizeof(io_uring_buf);
+    void *ring = mmap(nullptr, this->_bufRingSize, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ring == MAP_FAILED)
+        throw error::SocketError(systemError("Buffer ring allocation failed"));
+    this->_bufRing = static_cast<io_uring_buf_ring *>(ring);
+    this->_buffers = std::make_unique<char[]>(bufferCount * bufferSize);
+
+    registration.ring_addr = reinterpret_cast<uint64_t>(ring);
+    registration.ring_entries = bufferCount;
+    registration.bgid = 0;
+    if (ioUringRegister(this->_ring, IORING_REGISTER_PBUF_RING, &registration, 1) < 0)
+        throw error::SocketError(
+            systemError("io_uring buffer ring unavailable (kernel < 5.19)"));
+    for (unsigned i = 0; i < bufferCount; i += 1)
+        this->_recycleBuffer(static_cast<uint16_t>(i));
+}
+
+void zappy::server::UringBackend::_release()
+{
+    if (this->_bufRing)
+        munmap(this->_bufRing, this->_bufRingSize);
+    if (this->_sqes)
+        munmap(this->_sqes, this->_sqesSize);
+    if (this->_cqMap && this->_cqMap != this->_sqMap)
+        munmap(this->_cqMap, this->_cqMapSize);
+    if (this->_sqMap)
+        munmap(this->_sqMap, this->_sqMapSize);
+    if (this->_ring >= 0)
+        ::close(this->_ring);
+    this->_bufRing = nullptr;
+    this->_sqes = nullptr;
+    this->_cqMap = nullptr;
+    this->_sqMap = nullptr;
+    this->_ring = -1;
+}
+
+void zappy::server::UringBackend::_recycleBuffer(uint16_t bufferId)
+{
+    // bufs is a flexible array member, shifted by 8 bytes when the header
+    // is compiled as C++: the slots are indexed from the ring start instead
+    auto *slots = reinterpret_cast<io_uring_buf *>(this->_bufRing);
+    io_uring_buf &buffer = slots[this->_bufTail & (bufferCount - 1)];
+
+    buffer.addr = reinterpret_cast<uint64_t>(
+        this->_buffers.get() + static_cast<size_t>(bufferId) * bufferSize);
+    buffer.len = bufferSize;
+    buffer.bid = bufferId;
+    this->_bufTail += 1;
+    __atomic_store_n(&this->_bufRing->tail, this->_bufTail, __ATOMIC_RELEASE);
+}
+
+io_uring_sqe *zappy::server::UringBackend::_getSqe()
+{
+    if (this->_sqLocalTail - __atomic_load_n(this->_sqHead, __ATOMIC_ACQUIRE) >=
+        this->_sqEntries)
+        this->_enter(0);
+
+    unsigned index = this->_sqLocalTail & *this->_sqMask;
+    io_uring_sqe *sqe = &this->_sqes[index];
+
+    std::memset(sqe, 0, sizeof(*sqe));
+    this->_sqArray[index] = index;
+    this->_sqLocalTail += 1;
+    return sqe;
+}
+
+void zappy::server::UringBackend::_enter(int waitMs)
+{
+    __kernel_timespec timeout{};
+    io_uring_getevents_arg arg{};
+    unsigned flags = 0;
+    unsigned minComplete = 0;
+
+    __atomic_store_n(this->_sqTail, this->_sqLocalTail, __ATOMIC_RELEASE);
+    unsigned toSubmit =
+        this->_sqLocalTail - __atomic_load_n(this->_sqHead, __ATOMIC_ACQUIRE);
+    bool ready = __atomic_load_n(this->_cqTail, __ATOMIC_ACQUIRE) != *this->_cqHead;
+
+    if (waitMs > 0 && !ready) {
+        timeout.tv_nsec = static_cast<long long>(waitMs) * 1000000;
+        arg.ts = reinterpret_cast<uint64_t>(&timeout);
+        flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+        minComplete = 1;
+    }
+    if (toSubmit == 0 && minComplete == 0)
+        return;
+    networkSyscalls.fetch_add(1, std::memory_order_relaxed);
+    if (ioUringEnter(this->_ring, toSubmit, minComplete, flags,
+            flags ? &arg : nullptr, flags ? sizeof(arg) : 0) < 0 &&
+        errno != ETIME && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+        throw error::SocketError(systemError("io_uring_enter failed"));
+}
+
+void zappy::server::UringBackend::_armAccept()
+{
+    io_uring_sqe *sqe = this->_getSqe();
+
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = this->_listenSocket;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sqe->ioprio = this->_multishotAccept ? IORING_ACCEPT_MULTISHOT : 0;
+    sqe->user_data = static_cast<uint64_t>(Op::ACCEPT) << opShift;
+}
+
+void zappy::server::UringBackend::_armRecv(uint64_t id, int fd)
+{
+    io_uring_sqe *sqe = this->_getSqe();
+
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = 0;
+    sqe->ioprio = this->_multishotRecv ? IORING_RECV_MULTISHOT : 0;
+    sqe->len = this->_multishotRecv ? 0 : bufferSize;
+    sqe->user_data = (static_cast<uint64_t>(Op::RECV) << opShift) | id;
+}
+
+void zappy::server::UringBackend::_submitSend(uint64_t id, Connection &connection)
+{
+    auto chunk = connection.output.next();
+
+    if (chunk.empty())
+        return;
+
+    io_uring_sqe *sqe = this->_getSqe();
+
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = connection.fd;
+    sqe->addr = reinterpret_cast<uint64_t>(chunk.data());
+    sqe->len = static_cast<uint32_t>(chunk.size());
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = (static_cast<uint64_t>(Op::SEND) << opShift) | id;
+    connection.sending = true;
+}
+
+void zappy::server::UringBackend::schedule(
+    int socket, std::shared_ptr<ClientOutput> output)
+{
+    std::lock_guard<std::mutex> lock(this->_scheduleMutex);
+
+    this->_scheduled.emplace_back(socket, std::move(output));
+}
+
+/**
+ * @brief Move the buffers queued by the clients to their connection
+ *
+ * Runs on the network thread before each wait, so every message flushed
+ * since the previous iteration leaves in the same submission.
+ */
+void zappy::server::UringBackend::_drainOutputs()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_scheduleMutex);
+        this->_draining.swap(this->_scheduled);
+    }
+    for (auto &[fd, output] : this->_draining) {
+        std::lock_guard<std::mutex> lock(output->mutex);
+        auto id = this->_idByFd.find(fd);
+
+        output->scheduled = false;
+        if (id == this->_idByFd.end()) {
+            output->buffer.clear();
+            continue;
+        }
+        this->_queue(id->second, this->_connections[id->second], output->buffer);
+        output->buffer.clear();
+    }
+    this->_draining.clear();
+}
+
+void zappy::server::UringBackend::wait(
+    std::vector<NetworkEvent> &events, int timeoutMs)
+{
+    events.clear();
+    this->_drainOutputs();
+    this->_enter(timeoutMs);
+
+    unsigned head = *this->_cqHead;
+    unsigned tail = __atomic_load_n(this->_cqTail, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        this->_complete(this->_cqes[head & *this->_cqMask], events);
+        head += 1;
+    }
+    __atomic_store_n(this->_cqHead, head, __ATOMIC_RELEASE);
+    events.insert(events.end(), this->_notices.begin(), this->_notices.end());
+    this->_notices.clear();
+}
+
+void zappy::server::UringBackend::_complete(
+    const io_uring_cqe &cqe, std::vector<NetworkEvent> &events)
+{
+    auto op = static_cast<Op>(cqe.user_data >> opShift);
+    uint64_t id = cqe.user_data & idMask;
+
+    if (op == Op::RECV)
+        return this->_completeRecv(id, cqe, events);
+    if (op == Op::SEND)
+        return this->_completeSend(id, cqe);
+    if (cqe.res >= 0) {
+        id = this->_nextId;
+        this->_nextId += 1;
+        this->_connections[id].fd = cqe.res;
+        this->_idByFd[cqe.res] = id;
+        this->_armRecv(id, cqe.res);
+        events.push_back({NetworkEvent::Kind::ACCEPT, cqe.res, {}});
+    } else if (cqe.res == -EINVAL && this->_multishotAccept) {
+        this->_multishotAccept = false;
+    }
+    if (!(cqe.flags & IORING_CQE_F_MORE))
+        this->_armAccept();
+}
+
+void zappy::server::UringBackend::_completeRecv(
+    uint64_t id, const io_uring_cqe &cqe, std::vector<NetworkEvent> &events)
+{
+    auto it = this->_connections.find(id);
+    bool open = it != this->_connections.end() && it->second.fd >= 0;
+
+    if (cqe.flags & IORING_CQE_F_BUFFER) {
+        auto bufferId = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        if (open && cqe.res > 0)
+            events.push_back({NetworkEvent::Kind::DATA, it->second.fd,
+                std::string(this->_buffers.get() +
+                    static_cast<size_t>(bufferId) * bufferSize, cqe.res)});
+        this->_recycleBuffer(bufferId);
+    }
+    if (!open || (cqe.flags & IORING_CQE_F_MORE))
+        return;
+    if (cqe.res == -EINVAL && this->_multishotRecv) {
+        this->_multishotRecv = false;
+        return this->_armRecv(id, it->second.fd);
+    }
+    if (cqe.res > 0 || cqe.res == -ENOBUFS)
+        return this->_armRecv(id, it->second.fd);
+    if (!it->second.lost) {
+        it->second.lost = true;
+        events.push_back({NetworkEvent::Kind::CLOSED, it->second.fd, {}});
+    }
+}
+
+void zappy::server::UringBackend::_completeSend(uint64_t id, const io_uring_cqe &cqe)
+{
+    auto it = this->_connections.find(id);
+
+    if (it == this->_connections.end())
+        return;
+    auto &connection = it->second;
+    connection.sending = false;
+    if (cqe.res > 0)
+        connection.output.consume(static_cast<size_t>(cqe.res));
+    else
+        connection.output.clear();
+    if (connection.fd < 0) {
+        this->_connections.erase(it);
+        return;
+    }
+    if (connection.output.resume(this->_limits))
+        this->_notices.push_back({NetworkEvent::Kind::RESUMED, connection.fd, {}});
+    this->_submitSend(id, connection);
+}
+
+void zappy::server::UringBackend::send(int fd, std::string_view data)
+{
+    auto id = this->_idByFd.find(fd);
+
+    if (id == this->_idByFd.end())
+        return;
+    this->_queue(id->second, this->_connections[id->second], data);
+}
+
+void zappy::server::UringBackend::sendShared(
+    int fd, std::shared_ptr<const std::string> data)
+{
+    auto id = this->_idByFd.find(fd);
+
+    if (id == this->_idByFd.end())
+        return;
+    auto &connection = this->_connections[id->second];
+    this->_queued(id->second, connection,
+        connection.output.appendShared(std::move(data), this->_limits));
+}
+
+void zappy::server::UringBackend::_queue(
+    uint64_t id, Connection &connection, std::string_view data)
+{
+    this->_queued(id, connection, connection.output.append(data, this->_limits));
+}
+
+void zappy::server::UringBackend::_queued(
+    uint64_t id, Connection &connection, OutputQueue::Append result)
+{
+    if (result == OutputQueue::Append::OVERFLOW)
+        this->_notices.push_back({NetworkEvent::Kind::SLOW, connection.fd, {}});
+    if (connection.sending)
+        return;
+    this->_submitSend(id, connection);
+    if (!connection.sending && connection.output.resume(this->_limits))
+        this->_notices.push_back({NetworkEvent::Kind::RESUMED, connection.fd, {}});
+}
+
+/**
+ * @brief Close a client socket
+ *
+ * Entries prepared for it are submitted first: the kernel resolves the
+ * descriptor at submission time and the number may be reused by the next
+ * accept. shutdown() ends the multishot recv, which holds the socket. The
+ * connection is kept until its last send completes, the kernel still reads
+ * its buffer.
+ */
+void zappy::server::UringBackend::close(int fd)
+{
+    auto id = this->_idByFd.find(fd);
+
+    if (id == this->_idByFd.end())
+        return;
+    auto it = this->_connections.find(id->second);
+    this->_idByFd.erase(id);
+    if (this->_sqLocalTail != __atomic_load_n(this->_sqHead, __ATOMIC_ACQUIRE))
+        this->_enter(0);
+    ::shutdown(fd, SHUT_RDWR);
+    ::close(fd);
+    it->second.fd = -1;
+    it->second.output.dropPending();
+    if (!it->second.sending)
+        this->_connections.erase(it);
+}
+
+#else
+
+zappy::server::UringBackend::UringBackend(int listenSocket, const OutputLimits &limits)
+    : _listenSocket(listenSocket), _limits(limits)
+{
+    throw error::SocketError("io_uring is not supported by this build");
+}
+
+zappy::server::UringBackend::~UringBackend() = default;
+
+void zappy::server::UringBackend::wait(std::vector<NetworkEvent> &, int) {}
+
+void zappy::server::UringBackend::send(int, std::string_view) {}
+
+void zappy::server::UringBackend::sendShared(int, std::shared_ptr<const std::string>) {}
+
+void zappy::server::UringBackend::close(int) {}
+
+void zappy::server::UringBackend::schedule(int, std::shared_ptr<ClientOutput>) {}
+
+#endif
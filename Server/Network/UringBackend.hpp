@@ -0,0 +1,175 @@
+//
+// EPITECH PROJECT, 2025
+// UringBackend
+// File description:
+// io_uring network backend
+//
+
+#pragma once
+
+#include "ClientOutput.hpp"
+#include "INetworkBackend.hpp"
+#include "OutputQueue.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct io_uring_buf_ring;
+
+namespace zappy {
+
+    namespace server {
+
+        /**
+         * @class UringBackend
+         * @brief Linux io_uring backend, without liburing.
+         *
+         * One multishot accept and one multishot recv per client stay
+         * armed in the ring. Received bytes land in a ring of provided
+         * buffers. Sends are queued per client and submitted in batches,
+         * together with the wait, so that one io_uring_enter call serves
+         * every client active during a loop iteration.
+         *
+         * The backend is the IOutputSink of the clients it accepted: their
+         * flushes only queue the buffer, the network thread sends it.
+         */
+        class UringBackend : public INetworkBackend, public IOutputSink {
+           public:
+            static constexpr unsigned ringEntries = 1024;  ///< Submission queue size
+            static constexpr unsigned bufferCount = 512;   ///< Provided receive buffers, a power of two
+            static constexpr unsigned bufferSize = 4096;   ///< Size of one receive buffer
+
+            /**
+             * @brief Create the ring and arm the accept.
+             * @param listenSocket Socket accepting the clients.
+             * @param limits Watermarks of the client output queues.
+             * @throw error::SocketError if io_uring or a feature it needs
+             * is not available, the caller can then use PollBackend.
+             */
+            UringBackend(int listenSocket, const OutputLimits &limits);
+
+            /**
+             * @brief Close the ring and every client socket.
+             */
+            ~UringBackend() override;
+
+            UringBackend(const UringBackend &) = delete;
+            UringBackend &operator=(const UringBackend &) = delete;
+
+            void wait(std::vector<NetworkEvent> &events, int timeoutMs) override;
+            void send(int fd, std::string_view data) override;
+            void sendShared(int fd, std::shared_ptr<const std::string> data) override;
+            void close(int fd) override;
+            const char *getName() const override { return "uring"; }
+
+            void schedule(int socket, std::shared_ptr<ClientOutput> output) override;
+
+           private:
+            /**
+             * @brief Operation of a submission, stored in its user data.
+             */
+            enum class Op : uint64_t { ACCEPT = 1, RECV = 2, SEND = 3 };
+
+            /**
+             * @struct Connection
+             * @brief State of an accepted client.
+             */
+            struct Connection {
+                int fd = -1;            ///< Client socket, -1 once closed
+                bool sending = false;   ///< A send is in the ring
+                bool lost = false;      ///< CLOSED was already reported
+                OutputQueue output;     ///< Bytes not sent yet
+            };
+
+            int _listenSocket;  ///< Socket accepting the clients.
+            OutputLimits _limits;  ///< Watermarks of the queues.
+            int _ring = -1;     ///< io_uring file descriptor.
+
+            void *_sqMap = nullptr;   ///< Mapped submission ring.
+            size_t _sqMapSize = 0;    ///< Size of _sqMap.
+            void *_cqMap = nullptr;   ///< Mapped completion ring, may be _sqMap.
+            size_t _cqMapSize = 0;    ///< Size of _cqMap.
+            io_uring_sqe *_sqes = nullptr;  ///< Submission entries.
+            size_t _sqesSize = 0;           ///< Size of _sqes.
+
+            unsigned *_sqHead = nullptr;   ///< Consumed by the kernel.
+            unsigned *_sqTail = nullptr;   ///< Published to the kernel.
+            unsigned *_sqMask = nullptr;   ///< Index mask of the submission ring.
+            unsigned *_sqArray = nullptr;  ///< Indexes of the submitted entries.
+            unsigned _sqEntries = 0;       ///< Size of the submission ring.
+            unsigned _sqLocalTail = 0;     ///< Tail including unpublished entries.
+            unsigned *_cqHead = nullptr;   ///< Consumed by the server.
+            unsigned *_cqTail = nullptr;   ///< Produced by the kernel.
+            unsigned *_cqMask = nullptr;   ///< Index mask of the completion ring.
+            io_uring_cqe *_cqes = nullptr; ///< Completion entries.
+
+            io_uring_buf_ring *_bufRing = nullptr;  ///< Ring of provided buffers.
+            size_t _bufRingSize = 0;                ///< Size of _bufRing.
+            uint16_t _bufTail = 0;                  ///< Next slot of _bufRing.
+            std::unique_ptr<char[]> _buffers;       ///< Memory of the buffers.
+
+            bool _multishotRecv = true;    ///< Kernel supports multishot recv.
+            bool _multishotAccept = true;  ///< Kernel supports multishot accept.
+            uint64_t _nextId = 1;          ///< Id of the next connection.
+            std::unordered_map<uint64_t, Connection> _connections;  ///< By id.
+            std::unordered_map<int, uint64_t> _idByFd;  ///< Open sockets.
+            std::vector<NetworkEvent> _notices;  ///< SLOW and RESUMED events.
+
+            std::mutex _scheduleMutex;  ///< Guards _scheduled.
+            std::vector<std::pair<int, std::shared_ptr<ClientOutput>>>
+                _scheduled;  ///< Outputs queued by Client::flushMessages.
+            std::vector<std::pair<int, std::shared_ptr<ClientOutput>>>
+                _draining;   ///< Outputs being moved to their connection.
+
+            void _setupRing();
+            void _setupBuffers();
+            void _release();
+
+            /**
+             * @brief Get a free submission entry, submitting if the ring is full.
+             * @return The cleared entry.
+             */
+            io_uring_sqe *_getSqe();
+
+            /**
+             * @brief Publish the prepared entries and enter the kernel.
+             * @param waitMs Longest wait for a completion, 0 to only submit.
+             */
+            void _enter(int waitMs);
+
+            void _armAccept();
+            void _armRecv(uint64_t id, int fd);
+            void _submitSend(uint64_t id, Connection &connection);
+
+            /**
+             * @brief Queue data for a client and submit a send if none is
+             * in the ring.
+             * @param id Connection id.
+             * @param connection The open connection.
+             * @param data Bytes to send.
+             */
+            void _queue(uint64_t id, Connection &connection, std::string_view data);
+
+            /**
+             * @brief Submit a send after an append, if none is in the ring.
+             * @param id Connection id.
+             * @param connection The open connection.
+             * @param result Result of the append.
+             */
+            void _queued(uint64_t id, Connection &connection, OutputQueue::Append result);
+            void _recycleBuffer(uint16_t bufferId);
+            void _drainOutputs();
+            void _complete(const io_uring_cqe &cqe, std::vector<NetworkEvent> &events);
+            void _completeRecv(uint64_t id, const io_uring_cqe &cqe,
+                std::vector<NetworkEvent> &events);
+            void _completeSend(uint64_t id, const io_uring_cqe &cqe);
+        };
+
+    }  // namespace server
+}  // namespace zappy
@@ -11,6 +11,11 @@
 #include "Error.hpp"
 #include "Game.hpp"
 #include "my_macros.hpp"
+#include "PollBackend.hpp"
+#include "UringBackend.hpp"
+#include <algorithm>
+#include <chrono>
+#include <exception>
 #include <memory>
 
 zappy::server::Server::Server(int argc, char const *argv[])
@@ -20,18 +25,66 @@ zappy::server::Server::Server(int argc, char const *argv[])
         {"-x", [this](int value) {this->_width = value;}},
         {"-y", [this](int value) {this->_height = value;}},
         {"-c", [this](int value) {this->_clientNb = value;}},
-        {"-f", [this](int value) {this->_freq = value;}}
+        {"-f", [this](int value) {this->_freq = value;}},
+        {"-b", [this](int value) {this->_backlog = value;}},
+        {"-B", [this](int value) {this->_tickBudgetUs = std::max(value, 0);}},
+        {"-e", [this](int value) {this->_commandBudgetUs = std::max(value, 0);}},
+        {"-q", [this](int value) {
+            this->_outputLimits.high = static_cast<size_t>(value) << 10;
+            this->_outputLimits.low = this->_outputLimits.high / 4;
+        }},
+        {"-s", [this](int value) {
+            this->_seed = static_cast<unsigned int>(value);
+            this->_seedSet = true;
+        }}
+    };
+    this->_stringFlags = {
+        {"-l", [this](const std::string &path) {this->_snapshotLoad = path;}},
+        {"-w", [this](const std::string &path) {this->_snapshotSave = path;}},
+        {"-j", [this](const std::string &path) {this->_journalPath = path;}},
+        {"-N", [this](const std::string &name) {this->_networkName = name;}}
     };
     this->_parseFlags(argc, argv);
+    if (!this->_seedSet)
+        this->_seed = static_cast<unsigned int>(std::time(nullptr));
+    std::cout << "Random seed: " << this->_seed << std::endl;
     int &freq = this->_freq;
-    this->_game = std::make_unique<zappy::game::Game>(
-        this->_width, this->_height, this->_teamList, freq, this->_clientNb);
+    this->_game = std::make_unique<zappy::game::Game>(this->_width,
+        this->_height, this->_teamList, freq, this->_clientNb, this->_seed,
+        this->_snapshotLoad);
+    this->_game->setSnapshotSavePath(this->_snapshotSave);
+    this->_game->setTickBudget(std::chrono::microseconds(this->_tickBudgetUs));
+    this->_game->setCommandBudget(std::chrono::microseconds(this->_commandBudgetUs));
+    if (!this->_journalPath.empty())
+        this->_openJournal();
     this->_socket =
-        std::make_unique<server::SocketServer>(this->_port, this->_clientNb);
-    this->_fds.push_back({this->_socket->getSocket(), POLLIN, 0});
+        std::make_unique<server::SocketServer>(this->_port, this->_backlog);
+    this->_createNetwork();
     std::cout << "Zappy Server listening on port " << this->_port << "...\n";
 }
 
+void zappy::server::Server::_createNetwork()
+{
+    if (this->_networkName == "uring") {
+        try {
+            this->_network =
+                std::make_unique<UringBackend>(
+                this->_socket->getSocket(), this->_outputLimits);
+        } catch (const error::SocketError &e) {
+            std::cerr << "io_uring unavailable (" << e.what()
+                      << "), falling back to poll" << std::endl;
+        }
+    } else if (this->_networkName != "poll") {
+        throw error::InvalidArg("Unknown network backend " + this->_networkName);
+    }
+    if (!this->_network)
+        this->_network =
+            std::make_unique<PollBackend>(
+            this->_socket->getSocket(), this->_outputLimits);
+    this->_game->setOutputSink(dynamic_cast<IOutputSink *>(this->_network.get()));
+    std::cout << "Network backend: " << this->_network->getName() << std::endl;
+}
+
 int handleFlag(const std::string &flag)
 {
     std::stringstream stream;
@@ -82,12 +135,21 @@ void zappy::server::Server::_parseFlagsInt(int &index, std::string arg, std::str
 
 void zappy::server::Server::_checkParams()
 {
+    if (!this->_snapshotLoad.empty()) {
+        auto header = zappy::game::snapshot::readHeader(this->_snapshotLoad);
+        this->_width = header.width;
+        this->_height = header.height;
+    }
     if (this->_port == zappy::noValue || this->_width == zappy::noValue ||
         this->_height == zappy::noValue || this->_freq <= 0 || this->_clientNb == zappy::noValue ||
          this->_namesTeam.empty()) {
         throw error::InvalidArg(
             "Missing or Invalid arguments: -p -x -y -c -f -n <names>");
     }
+    if (this->_backlog <= 0)
+        throw error::InvalidArg("The backlog (-b) must be positive");
+    if (this->_outputLimits.high == 0)
+        throw error::InvalidArg("The output limit (-q) must be positive");
     if (this->_freq == zappy::noValue)
         this->_freq = 100;
 }
@@ -120,17 +182,70 @@ void zappy::server::Server::_parseFlags(int argc, char const *argv[])
             this->_parseName(i, argv);
             continue;
         }
+        auto stringFlag = this->_stringFlags.find(currentArg);
+        if (stringFlag != this->_stringFlags.end()) {
+            if (i + 1 >= argc)
+                throw error::InvalidArg("Missing file path after " + currentArg);
+            stringFlag->second(argv[i + 1]);
+            i += 1;
+            continue;
+        }
         this->_parseFlagsInt(i, currentArg, argv[i + 1]);
     }
 
     this->_checkParams();
 }
 
+void zappy::server::Server::_openJournal()
+{
+    JournalSettings settings;
+
+    if (!this->_snapshotLoad.empty())
+        throw error::InvalidArg("A journal cannot start from a snapshot (-l)");
+    settings.seed = this->_seed;
+    settings.width = this->_width;
+    settings.height = this->_height;
+    settings.clientNb = this->_clientNb;
+    settings.freq = this->_freq;
+    for (auto &name : this->_namesTeam) {
+        if (name != "GRAPHIC")
+            settings.teams.push_back(name);
+    }
+    this->_journal = std::make_unique<Journal>(this->_journalPath, settings);
+}
+
+void zappy::server::Server::_journalRecord(
+    JournalKind kind, int socket, std::string_view line)
+{
+    if (this->_journal)
+        this->_journal->record(kind, socket, this->_game->getTick(), line);
+}
+
 void zappy::server::Server::runServer()
 {
-    std::thread networkThread(&zappy::server::Server::runLoop, this);
-    std::thread gameThread(&game::Game::runGame, this->_game.get());
+    std::exception_ptr networkError;
+    std::exception_ptr gameError;
+    std::thread networkThread([this, &networkError]() {
+        try {
+            this->runLoop();
+        } catch (...) {
+            networkError = std::current_exception();
+            this->_game->setRunningState(RunningState::STOP);
+        }
+    });
+    std::thread gameThread([this, &gameError]() {
+        try {
+            this->_game->runGame();
+        } catch (...) {
+            gameError = std::current_exception();
+            this->setRunningState(RunningState::STOP);
+        }
+    });
 
     networkThread.join();
-    gameThread.join();  
+    gameThread.join();
+    if (networkError)
+        std::rethrow_exception(networkError);
+    if (gameError)
+        std::rethrow_exception(gameError);
 }
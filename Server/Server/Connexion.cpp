@@ -18,86 +18,130 @@ void zappy::server::Server::handleClientMessage(
         for (auto &player : team->getPlayerList()) {
             if (clientSocket == player->getClient().getSocket() &&
                 player->getClient().getState() == zappy::server::ClientState::CONNECTED) {
-                std::lock_guard<std::mutex> lock(*(player->getClient().queueMutex));
-                player->getClient().queueMessage.push(buffer);
+                this->_pushClientLine(player->getClient(), buffer);
                 return;
             }
         }
     }
-    this->sendMessage("ko\n", clientSocket);
+    this->_network->send(clientSocket, "ko\n");
+}
+
+void zappy::server::Server::_pushClientLine(
+    zappy::server::Client &client, std::string_view line)
+{
+    if (line.empty())
+        return;
+    if (!client.getInbox().push(line))
+        return client.sendMessage("ko\n");
+    clientLines.fetch_add(1, std::memory_order_relaxed);
+    this->_journalRecord(JournalKind::LINE, client.getSocket(), line);
 }
 
 zappy::server::ClientState zappy::server::Server::_handleClientDisconnection(
-    const std::string &content, struct pollfd &pfd)
+    const std::string &content, int fd)
 {
     if (content.compare("exit") == 0) {
-        auto optPlayer = this->getPlayerBySocket(pfd.fd);
+        auto optPlayer = this->getPlayerBySocket(fd);
         if (optPlayer.has_value() && optPlayer.value()->getTeam().getName() != "GRAPHIC") {
-            this->_game->getCommandHandler().messageToGUI("pdi #" +
-                std::to_string(optPlayer.value()->getId()) + "\n");
+            this->_game->getCommandHandler().messageToGUI(
+                "pdi #", optPlayer.value()->getId(), '\n');
         }
-        this->_game->removeFromTeam(pfd.fd);
-        ::close(pfd.fd);
+        this->_closeClient(fd);
         return ClientState::DISCONNECTED;
     }
     return ClientState::UNDEFINED;
 }
 
-bool zappy::server::Server::_handleNewConnection(struct pollfd &pfd)
+void zappy::server::Server::_closeClient(int fd)
 {
-    std::lock_guard<std::mutex> lock(this->_socketLock);
-    if (pfd.fd == this->_socket->getSocket()) {
-        this->_fds.push_back(this->_socket->acceptConnection());
-        return true;
-    }
-    return false;
+    this->_journalRecord(JournalKind::LEAVE, fd);
+    this->_partialLines.erase(fd);
+    this->_game->removeFromTeam(fd);
+    this->_network->close(fd);
 }
 
-void zappy::server::Server::pfdLoop()
+void zappy::server::Server::_handleSlowClient(const NetworkEvent &event)
 {
-    for (size_t i = 0; i < this->_fds.size();) {
-        auto &pfd = this->_fds[i];
+    auto optPlayer = this->getPlayerBySocket(event.fd);
+    bool isGui = optPlayer.has_value() &&
+        optPlayer.value()->getTeam().getName() == "GRAPHIC";
 
-        if (pfd.revents & POLLIN) {
-            try {
-                if (this->_handleNewConnection(pfd)) {
-                    ++i;
-                    continue;
-                }
-                auto content = this->_getClientCommand(pfd);
+    if (isGui) {
+        if (event.kind == NetworkEvent::Kind::RESUMED)
+            this->_initialCommandGui(*optPlayer.value());
+        else
+            std::cerr << "GUI on socket " << event.fd
+                      << " is too slow, dropping its output" << std::endl;
+        return;
+    }
+    if (event.kind == NetworkEvent::Kind::RESUMED)
+        return;
+    std::cerr << "Client on socket " << event.fd
+              << " is too slow, disconnecting it" << std::endl;
+    if (optPlayer.has_value())
+        this->_game->getCommandHandler().messageToGUI(
+            "pdi #", optPlayer.value()->getId(), '\n');
+    this->_closeClient(event.fd);
+}
 
-                if (this->_handleClientDisconnection(content, pfd) ==
-                    ClientState::DISCONNECTED) {
-                    this->_fds.erase(this->_fds.begin() + i);
-                    continue;
-                }
+void zappy::server::Server::_handleNetworkEvent(const NetworkEvent &event)
+{
+    if (event.kind == NetworkEvent::Kind::ACCEPT)
+        return this->_network->send(event.fd, "WELCOME\n");
+    if (event.kind == NetworkEvent::Kind::CLOSED)
+        return this->_closeClient(event.fd);
+    if (event.kind == NetworkEvent::Kind::SLOW ||
+        event.kind == NetworkEvent::Kind::RESUMED)
+        return this->_handleSlowClient(event);
+    this->_handleClientData(event);
+}
 
-                this->_handleClientCommand(content, pfd);
+void zappy::server::Server::_handleClientData(const NetworkEvent &event)
+{
+    std::string received;
+    auto partial = this->_partialLines.find(event.fd);
+    size_t start = 0;
 
-            } catch (const zappy::error::SocketError &e) {
-                close(pfd.fd);
-                this->_game->removeFromTeam(pfd.fd);
-                this->_fds.erase(this->_fds.begin() + i);
-                continue;
-            }
-        }
+    if (partial != this->_partialLines.end()) {
+        received = std::move(partial->second);
+        this->_partialLines.erase(partial);
+    }
+    received.append(event.data);
+    for (auto end = received.find('\n'); end != std::string::npos;
+        end = received.find('\n', start)) {
+        std::string line = received.substr(start, end - start);
 
-        ++i;
+        start = end + 1;
+        line.erase(line.find_last_not_of(endSequence) + 1);
+        if (this->_handleClientDisconnection(line, event.fd) ==
+            ClientState::DISCONNECTED)
+            return;
+        this->_handleClientCommand(line, event.fd);
     }
+    if (start < received.size())
+        this->_partialLines.emplace(event.fd, received.substr(start,
+            std::min(received.size() - start, CommandInbox::maxLineSize + 1)));
 }
 
-
 void zappy::server::Server::runLoop()
 {
     auto signalHandler = std::make_shared<zappy::utils::Signal>(*this, *_game);
     zappy::utils::Signal::initSignalHandling(signalHandler.get());
 
-    while (this->_serverRun == RunningState::RUN) {
-        this->_socket->getData(this->_fds);
+    std::vector<NetworkEvent> events;
+
+    try {
+        while (this->_serverRun == RunningState::RUN) {
+            this->_network->wait(events, 1);
 
-        if (this->_game->getRunningState() == RunningState::STOP)
-            this->setRunningState(RunningState::STOP);
-        this->pfdLoop();
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            if (this->_game->getRunningState() == RunningState::STOP)
+                this->setRunningState(RunningState::STOP);
+            for (auto &event : events)
+                this->_handleNetworkEvent(event);
+        }
+    } catch (...) {
+        zappy::utils::Signal::releaseSignalHandling(signalHandler.get());
+        throw;
     }
+    zappy::utils::Signal::releaseSignalHandling(signalHandler.get());
 }
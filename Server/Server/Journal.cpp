@@ -0,0 +1,100 @@
+//
+// EPITECH PROJECT, 2025
+// Journal
+// File description:
+// Append-only journal of the client input
+//
+
+#include "Journal.hpp"
+#include "Error.hpp"
+#include <cstring>
+
+namespace {
+    constexpr char journalMagic[4] = {'Z', 'P', 'Y', 'J'};
+
+    // Lit un entier brut, lève une erreur si le fichier est tronqué
+    template <typename T>
+    T readValue(std::ifstream &file)
+    {
+        T value{};
+
+        if (!file.read(reinterpret_cast<char *>(&value), sizeof(value)))
+            throw zappy::error::InvalidArg("Truncated journal");
+        return value;
+    }
+
+    std::string readString(std::ifstream &file)
+    {
+        auto size = readValue<uint16_t>(file);
+        std::string value(size, '\0');
+
+        if (size > 0 && !file.read(value.data(), size))
+            throw zappy::error::InvalidArg("Truncated journal");
+        return value;
+    }
+}  // namespace
+
+zappy::server::Journal::Journal(
+    const std::string &path, const JournalSettings &settings)
+    : _file(path, std::ios::binary | std::ios::trunc)
+{
+    if (!this->_file)
+        throw error::InvalidArg("Unable to create journal " + path);
+    this->_file.write(journalMagic, sizeof(journalMagic));
+    this->_write(version);
+    this->_write(settings.seed);
+    this->_write(settings.width);
+    this->_write(settings.height);
+    this->_write(settings.clientNb);
+    this->_write(settings.freq);
+    this->_write(static_cast<uint32_t>(settings.teams.size()));
+    for (auto &team : settings.teams) {
+        this->_write(static_cast<uint16_t>(team.size()));
+        this->_file.write(team.data(), team.size());
+    }
+    this->_file.flush();
+}
+
+void zappy::server::Journal::record(JournalKind kind, uint32_t connection,
+    uint32_t tick, std::string_view line)
+{
+    this->_write(tick);
+    this->_write(connection);
+    this->_write(static_cast<uint8_t>(kind));
+    this->_write(static_cast<uint16_t>(line.size()));
+    this->_file.write(line.data(), line.size());
+}
+
+std::vector<zappy::server::JournalRecord> zappy::server::Journal::load(
+    const std::string &path, JournalSettings &settings)
+{
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(journalMagic)] = {0};
+    std::vector<JournalRecord> records;
+
+    if (!file || !file.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, journalMagic, sizeof(magic)) != 0)
+        throw error::InvalidArg("Not a zappy journal: " + path);
+    if (readValue<uint32_t>(file) != version)
+        throw error::InvalidArg("Unsupported journal version");
+    settings.seed = readValue<uint32_t>(file);
+    settings.width = readValue<uint32_t>(file);
+    settings.height = readValue<uint32_t>(file);
+    settings.clientNb = readValue<uint32_t>(file);
+    settings.freq = readValue<uint32_t>(file);
+    settings.teams.resize(readValue<uint32_t>(file));
+    for (auto &team : settings.teams)
+        team = readString(file);
+    while (file.peek() != std::ifstream::traits_type::eof()) {
+        JournalRecord record;
+
+        record.tick = readValue<uint32_t>(file);
+        record.connection = readValue<uint32_t>(file);
+        record.kind = static_cast<JournalKind>(readValue<uint8_t>(file));
+        if (record.kind > JournalKind::LEAVE)
+            throw error::InvalidArg("Invalid journal record");
+        record.line = readString(file);
+        records.push_back(std::move(record));
+    }
+    return records;
+}
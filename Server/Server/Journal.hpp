@@ -0,0 +1,108 @@
+//
+// EPITECH PROJECT, 2025
+// Journal
+// File description:
+// Append-only journal of the client input
+//
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zappy {
+    namespace server {
+
+        /**
+         * @enum JournalKind
+         * @brief Type d'un enregistrement du journal.
+         */
+        enum class JournalKind : uint8_t {
+            JOIN = 0,  ///< Le client a rejoint l'équipe donnée en ligne
+            LINE = 1,  ///< Ligne de commande acceptée dans la file du client
+            LEAVE = 2  ///< Le client s'est déconnecté
+        };
+
+        /**
+         * @struct JournalSettings
+         * @brief Paramètres de la partie nécessaires pour la rejouer.
+         */
+        struct JournalSettings {
+            uint32_t seed = 0;      ///< Graine du générateur aléatoire
+            uint32_t width = 0;     ///< Largeur de la carte
+            uint32_t height = 0;    ///< Hauteur de la carte
+            uint32_t clientNb = 0;  ///< Nombre de clients par équipe
+            uint32_t freq = 0;      ///< Fréquence de la partie
+            std::vector<std::string> teams;  ///< Équipes joueurs, sans GRAPHIC
+        };
+
+        /**
+         * @struct JournalRecord
+         * @brief Entrée lue depuis un journal.
+         */
+        struct JournalRecord {
+            uint32_t tick;        ///< Unité de temps de jeu de l'entrée
+            uint32_t connection;  ///< Identifiant de la connexion
+            JournalKind kind;     ///< Type de l'entrée
+            std::string line;     ///< Équipe (JOIN) ou commande (LINE)
+        };
+
+        /**
+         * @class Journal
+         * @brief Écrit le journal binaire des entrées clients acceptées.
+         *
+         * Format : en-tête "ZPYJ", version, puis JournalSettings, puis une
+         * suite d'enregistrements { tick u32, connexion u32, type u8,
+         * taille u16, octets }. Tous les entiers sont dans l'ordre natif.
+         * Le journal n'est écrit que par le thread réseau.
+         */
+        class Journal {
+           public:
+            /// Version du format, incrémentée à chaque changement
+            static constexpr uint32_t version = 1;
+
+            /**
+             * @brief Crée le journal et écrit son en-tête.
+             * @param path Chemin du fichier.
+             * @param settings Paramètres de la partie.
+             */
+            Journal(const std::string &path, const JournalSettings &settings);
+
+            /**
+             * @brief Ajoute un enregistrement.
+             * @param kind Type de l'entrée.
+             * @param connection Identifiant de la connexion.
+             * @param tick Unité de temps de jeu courante.
+             * @param line Équipe ou commande, vide pour LEAVE.
+             */
+            void record(JournalKind kind, uint32_t connection, uint32_t tick,
+                std::string_view line = {});
+
+            /**
+             * @brief Lit un journal complet.
+             * @param path Chemin du fichier.
+             * @param settings Paramètres de la partie lus dans l'en-tête.
+             * @return std::vector<JournalRecord> Enregistrements dans l'ordre.
+             */
+            static std::vector<JournalRecord> load(
+                const std::string &path, JournalSettings &settings);
+
+           private:
+            std::ofstream _file;  ///< Fichier du journal
+
+            /**
+             * @brief Écrit un entier brut dans le fichier.
+             * @param value Valeur à écrire.
+             */
+            template <typename T>
+            void _write(T value)
+            {
+                this->_file.write(
+                    reinterpret_cast<const char *>(&value), sizeof(value));
+            }
+        };
+    }  // namespace server
+}  // namespace zappy
@@ -0,0 +1,150 @@
+//
+// EPITECH PROJECT, 2025
+// Replay
+// File description:
+// Replay of a client input journal
+//
+
+#include "Replay.hpp"
+#include "Error.hpp"
+#include "ServerPlayer.hpp"
+#include "TeamsGui.hpp"
+#include "TeamsPlayer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+
+zappy::server::Replay::Replay(const std::string &path, int freq)
+{
+    constexpr int guiId = 0;
+
+    this->_records = Journal::load(path, this->_settings);
+    this->_freq = freq == noValue ? static_cast<int>(this->_settings.freq) : freq;
+    if (this->_freq <= 0)
+        throw error::InvalidArg("Invalid replay frequency");
+
+    int teamId = 1;
+    for (auto &name : this->_settings.teams) {
+        this->_teamList.push_back(
+            std::make_shared<zappy::game::TeamsPlayer>(name, teamId));
+        teamId += 1;
+    }
+    this->_teamList.push_back(
+        std::make_shared<zappy::game::TeamsGui>("GRAPHIC", guiId));
+    this->_game = std::make_unique<zappy::game::Game>(this->_settings.width,
+        this->_settings.height, this->_teamList, this->_freq,
+        this->_settings.clientNb, this->_settings.seed);
+}
+
+bool zappy::server::Replay::_apply(const JournalRecord &record)
+{
+    if (record.kind == JournalKind::JOIN) {
+        int fd = ::open("/dev/null", O_WRONLY);
+
+        if (fd == -1)
+            throw error::ServerConnection("Unable to open /dev/null");
+        this->_connections[record.connection] = fd;
+        this->_game->handleTeamJoin(fd, record.line);
+        return true;
+    }
+    auto connection = this->_connections.find(record.connection);
+    if (connection == this->_connections.end())
+        return true;
+    int fd = connection->second;
+    if (record.kind == JournalKind::LEAVE) {
+        this->_game->removeFromTeam(fd);
+        ::close(fd);
+        this->_connections.erase(connection);
+        return true;
+    }
+    for (auto &team : this->_game->getTeamList()) {
+        for (auto &player : team->getPlayerList()) {
+            if (player->getClient().getSocket() == fd)
+                return player->getClient().getInbox().push(record.line);
+        }
+    }
+    return true;
+}
+
+bool zappy::server::Replay::_hasRunnable()
+{
+    for (auto &team : this->_game->getTeamList()) {
+        for (auto &player : team->getPlayerList()) {
+            if (!player->isInAction() && !player->getClient().isOutputHeld() &&
+                !player->getClient().getInbox().empty())
+                return true;
+        }
+    }
+    return false;
+}
+
+bool zappy::server::Replay::_isIdle()
+{
+    for (auto &team : this->_game->getTeamList()) {
+        for (auto &player : team->getPlayerList()) {
+            if (player->isInAction() || !player->getClient().getInbox().empty())
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Replay the whole journal on a virtual clock
+ *
+ * Each loop runs one step of the game, feeds the records of the tick it
+ * reached and waits for the command threads to block. When no client can
+ * start a command, the clock jumps to the next thing that can happen: a
+ * command delay ending, a meal, a respawn or the tick of the next record.
+ * Nothing sleeps, so the replay takes the time of the work alone.
+ */
+void zappy::server::Replay::run()
+{
+    auto start = std::chrono::steady_clock::now();
+    auto &clock = this->_game->getClock();
+    size_t replayed = 0;
+
+    clock.setVirtual(start);
+    this->_game->startGame();
+    while (this->_game->getRunningState() != RunningState::STOP) {
+        this->_game->step();
+        while (replayed < this->_records.size() &&
+            this->_records[replayed].tick <= this->_game->getTick() &&
+            this->_apply(this->_records[replayed]))
+            replayed += 1;
+        clock.waitIdle();
+        if (this->_hasRunnable())
+            continue;
+        if (replayed == this->_records.size() && this->_isIdle())
+            break;
+        auto target = this->_game->getNextRuleTime();
+        auto deadline = clock.nextDeadline();
+
+        if (deadline)
+            target = std::min(target, *deadline);
+        if (replayed < this->_records.size())
+            target = std::min(target,
+                this->_game->getTickTime(this->_records[replayed].tick));
+        if (target <= clock.now())
+            target = this->_game->getTickTime(this->_game->getTick() + 1);
+        clock.advance(target);
+    }
+    for (auto deadline = clock.nextDeadline(); deadline;
+        deadline = clock.nextDeadline()) {
+        clock.advance(*deadline);
+        clock.waitIdle();
+    }
+    uint32_t ticks = this->_game->getTick();
+    this->_game->setRunningState(RunningState::STOP);
+    this->_game->stopGame();
+    for (auto &connection : this->_connections)
+        ::close(connection.second);
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << "Replayed " << replayed << "/" << this->_records.size()
+              << " records, " << ticks << " ticks in " << elapsed.count()
+              << " ms at f=" << this->_freq << std::endl;
+}
@@ -0,0 +1,82 @@
+//
+// EPITECH PROJECT, 2025
+// Replay
+// File description:
+// Replay of a client input journal
+//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Game.hpp"
+#include "Journal.hpp"
+
+namespace zappy {
+
+    namespace server {
+
+        /**
+         * @class Replay
+         * @brief Rejoue un journal dans le jeu, sans socket.
+         *
+         * Le jeu est recréé avec les paramètres et la graine du journal,
+         * puis chaque entrée est réinjectée quand le jeu atteint son unité
+         * de temps. Les clients rejoués écrivent dans /dev/null. Le jeu
+         * tourne sur une horloge virtuelle qui saute d'un événement au
+         * suivant (fin d'une commande, repas, réapparition, entrée du
+         * journal) : rien ne dort, la durée du rejeu ne dépend que du
+         * travail à faire.
+         */
+        class Replay {
+           public:
+            /**
+             * @brief Charge le journal et crée le jeu.
+             * @param path Chemin du journal.
+             * @param freq Fréquence du jeu rejoué, noValue pour la
+             * fréquence enregistrée.
+             */
+            Replay(const std::string &path, int freq);
+
+            /**
+             * @brief Rejoue tout le journal puis affiche le temps écoulé.
+             */
+            void run();
+
+           private:
+            JournalSettings _settings;            ///< Paramètres enregistrés
+            std::vector<JournalRecord> _records;  ///< Entrées à rejouer
+            std::vector<std::shared_ptr<zappy::game::ITeams>>
+                _teamList;                        ///< Équipes de la partie
+            int _freq = noValue;                  ///< Fréquence du rejeu
+            std::unique_ptr<zappy::game::Game> _game = nullptr;  ///< Jeu rejoué
+            std::unordered_map<uint32_t, int>
+                _connections;  ///< Connexion enregistrée vers descripteur
+
+            /**
+             * @brief Applique une entrée du journal au jeu.
+             * @param record Entrée à appliquer.
+             * @return false si la file du client est pleine, l'entrée est
+             * à réappliquer après la prochaine étape du jeu.
+             */
+            bool _apply(const JournalRecord &record);
+
+            /**
+             * @brief Indique si un client peut commencer une commande.
+             * @return true si la prochaine étape du jeu a du travail.
+             */
+            bool _hasRunnable();
+
+            /**
+             * @brief Indique si plus aucune commande n'est en attente ou en
+             * cours.
+             * @return true si le jeu n'a plus rien à traiter.
+             */
+            bool _isIdle();
+        };
+
+    }  // namespace server
+}  // namespace zappy
@@ -0,0 +1,85 @@
+//
+// EPITECH PROJECT, 2025
+// RoomHost
+// File description:
+// Several independent games in one server process
+//
+
+#include "RoomHost.hpp"
+#include "Error.hpp"
+#include <algorithm>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+zappy::server::RoomHost::RoomHost(const std::string &path)
+{
+    std::ifstream file(path);
+    std::string line;
+    size_t lineNumber = 0;
+
+    if (!file)
+        throw error::InvalidArg("Unable to open room file " + path);
+    while (std::getline(file, line)) {
+        lineNumber += 1;
+        auto start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#')
+            continue;
+        this->_addRoom(line, lineNumber);
+    }
+    if (this->_rooms.empty())
+        throw error::InvalidArg("No room in " + path);
+}
+
+void zappy::server::RoomHost::_addRoom(const std::string &line, size_t lineNumber)
+{
+    std::istringstream stream(line);
+    std::vector<std::string> words{"zappy_server"};
+    std::vector<const char *> argv;
+    std::string word;
+
+    while (stream >> word)
+        words.push_back(word);
+    // Rooms started in the same second would share the default time seed
+    if (std::find(words.begin(), words.end(), "-s") == words.end()) {
+        words.push_back("-s");
+        words.push_back(std::to_string(
+            static_cast<unsigned int>(std::time(nullptr)) + this->_rooms.size()));
+    }
+    for (auto &arg : words)
+        argv.push_back(arg.c_str());
+    argv.push_back(nullptr);
+    std::cout << "Room " << this->_rooms.size() << " (line " << lineNumber
+              << "):" << std::endl;
+    try {
+        this->_rooms.push_back(std::make_unique<Server>(
+            static_cast<int>(words.size()), argv.data()));
+    } catch (const error::Error &e) {
+        throw error::InvalidArg(
+            "Room at line " + std::to_string(lineNumber) + ": " + e.what());
+    }
+}
+
+void zappy::server::RoomHost::run()
+{
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < this->_rooms.size(); i += 1) {
+        threads.emplace_back([this, i]() {
+            try {
+                this->_rooms[i]->runServer();
+            } catch (const error::Error &e) {
+                std::cerr << "Room " << i << " stopped: " << e.what()
+                          << std::endl;
+            } catch (const std::exception &e) {
+                std::cerr << "Room " << i << " stopped: " << e.what()
+                          << std::endl;
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+}
@@ -0,0 +1,60 @@
+//
+// EPITECH PROJECT, 2025
+// RoomHost
+// File description:
+// Several independent games in one server process
+//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Server.hpp"
+
+namespace zappy {
+
+    namespace server {
+
+        /**
+         * @class RoomHost
+         * @brief Héberge plusieurs parties indépendantes dans un processus.
+         *
+         * Chaque ligne du fichier de salles contient les flags d'une partie,
+         * comme sur la ligne de commande (-p -x -y -n -c -f, et -s -N -l -w
+         * -j si besoin). Une salle a son propre port, sa carte, ses équipes
+         * et sa fréquence. Ses threads ne sont pas fixés sur un cœur : le
+         * thread de jeu crée les threads des commandes et du rendu, qui
+         * hériteraient de son cœur. Une salle qui s'arrête sur une erreur
+         * n'arrête pas les autres.
+         */
+        class RoomHost {
+           public:
+            /**
+             * @brief Lit le fichier de salles et crée chaque serveur.
+             *
+             * Les lignes vides et celles commençant par '#' sont ignorées.
+             * @param path Chemin du fichier de salles.
+             * @throw error::InvalidArg si le fichier ou une salle est invalide.
+             */
+            explicit RoomHost(const std::string &path);
+
+            /**
+             * @brief Lance toutes les salles et attend leur fin.
+             */
+            void run();
+
+           private:
+            std::vector<std::unique_ptr<Server>> _rooms;  ///< Une par salle
+
+            /**
+             * @brief Crée le serveur d'une ligne du fichier.
+             * @param line Flags de la salle.
+             * @param lineNumber Numéro de la ligne, pour les erreurs.
+             */
+            void _addRoom(const std::string &line, size_t lineNumber);
+        };
+
+    }  // namespace server
+}  // namespace zappy
@@ -16,12 +16,18 @@
 #include <poll.h>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "Client/Client.hpp"
 #include "Error/Error.hpp"
 #include "Game.hpp"
+#include "INetworkBackend.hpp"
+#include "Journal.hpp"
+#include "NetworkStats.hpp"
+#include "OutputQueue.hpp"
 #include "SocketServer.hpp"
 #include "TeamsGui.hpp"
 #include "Utils.hpp"
@@ -54,6 +60,10 @@ namespace zappy {
 
             /**
              * @brief Lance le serveur.
+             *
+             * Une erreur du thread réseau ou du thread de jeu arrête
+             * l'autre thread puis est relancée ici, une fois les deux
+             * threads terminés.
              */
             void runServer();
 
@@ -86,15 +96,10 @@ namespace zappy {
              */
             void runLoop();
 
-            /**
-             * @brief Effectue une boucle de gestion des événements poll.
-             */
-            void pfdLoop();
-
             /**
              * @brief Traite un message reçu d'un client.
              * @param clientSocket Le socket du client.
-             * @param buffer Le contenu du message.
+             * @param buffer La ligne reçue, sans son '\n'.
              */
             void handleClientMessage(int clientSocket, std::string buffer);
 
@@ -129,7 +134,7 @@ namespace zappy {
              */
             void sendMessage(const std::string &buf, int socket)
             {
-                send(socket, buf.c_str(), buf.size(), 0);
+                this->_network->send(socket, buf);
             }
 
             /**
@@ -151,12 +156,16 @@ namespace zappy {
             RunningState _serverRun =
                 RunningState::RUN;  ///< État de fonctionnement du serveur.
 
-            std::vector<struct pollfd> _fds;  ///< Liste des pollfd.
+            std::unique_ptr<INetworkBackend> _network =
+                nullptr;  ///< Backend réseau choisi par -N.
 
             std::vector<std::shared_ptr<zappy::game::ITeams>>
                 _teamList;  ///< Liste des équipes.
             std::unordered_map<std::string, std::function<void(int)>>
                 _flags;  ///< Flags et leurs fonctions associées.
+            std::unordered_map<std::string,
+                std::function<void(const std::string &)>>
+                _stringFlags;  ///< Flags prenant un chemin de fichier.
 
             std::mutex _socketLock;  ///< Mutex pour accès socket.
             std::mutex _endLock;     ///< Mutex pour fin de boucle.
@@ -166,7 +175,21 @@ namespace zappy {
             int _height = noValue;    ///< Hauteur de la carte.
             int _clientNb = noValue;  ///< Nombre maximal de clients.
             int _freq = noValue;      ///< Fréquence du serveur.
+            int _backlog = SOMAXCONN; ///< File des connexions non acceptées.
+            int _tickBudgetUs = 0;    ///< Durée maximale d'une boucle, 0 pour une unité de temps.
+            int _commandBudgetUs = 0; ///< Durée des commandes d'une unité de temps, 0 sans limite.
+            OutputLimits _outputLimits;  ///< Limites des files de sortie.
             std::vector<std::string> _namesTeam;  ///< Noms des équipes.
+            std::string _snapshotLoad;  ///< Snapshot chargé au démarrage.
+            std::string _snapshotSave;  ///< Snapshot écrit à l'arrêt.
+            std::string _journalPath;   ///< Journal des entrées clients.
+            std::string _networkName = "poll";  ///< Backend réseau demandé.
+            unsigned int _seed = 0;     ///< Graine du générateur aléatoire.
+            bool _seedSet = false;      ///< Graine donnée par -s.
+            std::unique_ptr<Journal> _journal =
+                nullptr;  ///< Journal ouvert, nul si désactivé.
+            std::unordered_map<int, std::string>
+                _partialLines;  ///< Fin de lecture sans '\n', par socket.
 
             /**
              * @brief Analyse les flags passés en arguments.
@@ -197,43 +220,95 @@ namespace zappy {
             void _checkParams();
 
             /**
-             * @brief Gère une nouvelle connexion si elle est détectée sur un pollfd.
-             * @param pfd Le pollfd à vérifier.
-             * @return true si une nouvelle connexion a été acceptée, false sinon.
+             * @brief Crée le journal demandé par -j avec les paramètres de
+             * la partie.
+             */
+            void _openJournal();
+
+            /**
+             * @brief Crée le backend réseau demandé par -N.
+             *
+             * Si io_uring n'est pas disponible, le backend poll est utilisé
+             * à la place.
+             */
+            void _createNetwork();
+
+            /**
+             * @brief Traite un événement rendu par le backend réseau.
+             * @param event L'événement.
+             */
+            void _handleNetworkEvent(const NetworkEvent &event);
+
+            /**
+             * @brief Traite les lignes complètes reçues d'un client.
+             *
+             * La fin d'une lecture qui n'a pas encore reçu son '\n' est
+             * gardée jusqu'à la lecture suivante. Elle est tronquée après
+             * la taille maximale d'une ligne, la ligne entière reçoit alors
+             * un seul "ko".
+             * @param event Événement DATA.
+             */
+            void _handleClientData(const NetworkEvent &event);
+
+            /**
+             * @brief Retire un client du jeu et ferme son socket.
+             * @param fd Le socket du client.
+             */
+            void _closeClient(int fd);
+
+            /**
+             * @brief Applique la politique des clients trop lents.
+             *
+             * Une GUI perd les messages jusqu'à ce qu'elle rattrape son
+             * retard, puis reçoit un état complet du jeu. Un autre client
+             * est déconnecté.
+             * @param event Événement SLOW ou RESUMED.
+             */
+            void _handleSlowClient(const NetworkEvent &event);
+
+            /**
+             * @brief Place une ligne dans la file de commandes du client.
+             *
+             * Une ligne refusée (file pleine, déjà 10 commandes en attente
+             * ou en cours) reçoit directement "ko" sans passer par le jeu.
+             * @param client Le client destinataire.
+             * @param line La ligne reçue, sans son '\n'.
              */
-            bool _handleNewConnection(struct pollfd &pfd);
+            void _pushClientLine(
+                zappy::server::Client &client, std::string_view line);
 
             /**
-             * @brief Récupère la commande envoyée par un client.
-             * @param fd Le pollfd du client.
-             * @return La commande reçue.
+             * @brief Ajoute une entrée au journal s'il est activé.
+             * @param kind Type de l'entrée.
+             * @param socket Socket du client concerné.
+             * @param line Équipe ou commande.
              */
-            std::string _getClientCommand(const struct pollfd &fd);
+            void _journalRecord(
+                JournalKind kind, int socket, std::string_view line = {});
 
             /**
              * @brief Gère la déconnexion d'un client.
              * @param content Contenu reçu.
-             * @param fd Le pollfd du client.
+             * @param fd Le socket du client.
              * @return L'état du client après traitement.
              */
             ClientState _handleClientDisconnection(
-                const std::string &content, struct pollfd &fd);
+                const std::string &content, int fd);
 
             /**
              * @brief Gère la commande envoyée par un client.
              * @param command La commande reçue.
-             * @param pfd Le pollfd du client.
+             * @param fd Le socket du client.
              */
-            void _handleClientCommand(
-                const std::string &command, struct pollfd &pfd);
+            void _handleClientCommand(const std::string &command, int fd);
 
             /**
              * @brief Ajoute un joueur à une équipe après connexion.
              * @param team L'équipe concernée.
-             * @param pfd Le pollfd du client.
+             * @param fd Le socket du client.
              */
-            void _playerConnect(std::shared_ptr<zappy::game::ITeams> &team,
-                struct pollfd &pfd);
+            void _playerConnect(
+                std::shared_ptr<zappy::game::ITeams> &team, int fd);
 
             /**
              * @brief Gère la connexion d'une interface graphique.
@@ -242,11 +317,11 @@ namespace zappy {
             void _guiConnect(std::shared_ptr<zappy::game::ITeams> &team);
 
             /**
-             * @brief Envoie les commandes initiales à la GUI.
-             * @param teamsGui Instance de TeamsGui.
+             * @brief Envoie l'état complet du jeu à une GUI, en une seule
+             * écriture partagée avec les GUI arrivées pendant le même tick.
+             * @param gui Le joueur de la GUI.
              */
-            void _initialCommandGui(
-                std::shared_ptr<zappy::game::TeamsGui> &teamsGui);
+            void _initialCommandGui(zappy::game::ServerPlayer &gui);
         };
 
     }  // namespace server
@@ -6,12 +6,15 @@
 */
 
 #include "Utils.hpp"
+#include <algorithm>
 #include <csignal>
+#include <pthread.h>
 #include <stdexcept>
 #include "Server.hpp"
 
 
-zappy::utils::Signal* zappy::utils::Signal::_instance = nullptr;
+std::vector<zappy::utils::Signal *> zappy::utils::Signal::_instances;
+std::mutex zappy::utils::Signal::_instancesLock;
 
 zappy::utils::Signal::Signal(zappy::server::Server &server, zappy::game::Game &game) : _server(server), _game(game) {}
 
@@ -22,13 +25,37 @@ void zappy::utils::Signal::onNotify(int sig)
 
 void zappy::utils::Signal::initSignalHandling(Signal *instance)
 {
-    _instance = instance;
+    _updateInstances([instance]() { _instances.push_back(instance); });
 
     my_signal(SIGINT, signalWrapper);
     my_signal(SIGTERM, signalWrapper);
     my_signal(SIGPIPE, SIG_IGN);
 }
 
+void zappy::utils::Signal::releaseSignalHandling(Signal *instance)
+{
+    _updateInstances([instance]() {
+        _instances.erase(std::remove(_instances.begin(), _instances.end(), instance),
+            _instances.end());
+    });
+}
+
+void zappy::utils::Signal::_updateInstances(const std::function<void()> &update)
+{
+    sigset_t mask;
+    sigset_t previous;
+
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &mask, &previous);
+    {
+        std::lock_guard<std::mutex> lock(_instancesLock);
+        update();
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+}
+
 void zappy::utils::Signal::my_signal(int sig, sighandler_t handler)
 {
     if (signal(sig, handler) == SIG_ERR)
@@ -37,13 +64,36 @@ void zappy::utils::Signal::my_signal(int sig, sighandler_t handler)
 
 void zappy::utils::Signal::signalWrapper(int sig)
 {
-    if (_instance)
-        _instance->stopServer(sig);
+    std::lock_guard<std::mutex> lock(_instancesLock);
+
+    if (_instances.empty())
+        return;
+    _printShutdown(sig);
+    for (auto *instance : _instances)
+        instance->_stop();
 }
 
 void zappy::utils::Signal::stopServer(int sig)
+{
+    _printShutdown(sig);
+    _stop();
+}
+
+void zappy::utils::Signal::_printShutdown(int sig)
 {
     std::cout << "Received signal " << sig << ". Closing server..." << std::endl;
+    std::cout << "Message buffer allocations: "
+              << zappy::server::messageAllocations.load() << std::endl;
+    std::cout << "Network syscalls: " << zappy::server::networkSyscalls.load()
+              << " for " << zappy::server::clientLines.load()
+              << " client lines" << std::endl;
+    std::cout << "Output queues: " << zappy::server::peakQueuedBytes.load()
+              << " bytes at peak, " << zappy::server::slowConsumers.load()
+              << " slow clients" << std::endl;
+}
+
+void zappy::utils::Signal::_stop()
+{
     _server.setRunningState(RunningState::STOP);
     _game.setRunningState(RunningState::STOP);
     
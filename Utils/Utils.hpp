@@ -8,7 +8,10 @@
 #pragma once
 
 #include <csignal>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <vector>
 
 #include "IObserver.hpp"
 
@@ -48,10 +51,19 @@ namespace zappy {
 
             /**
              * @brief Initialise le traitement des signaux avec l'instance donnée.
-             * @param instance Instance de Signal à utiliser.
+             *
+             * Chaque salle d'un serveur multi-salles ajoute la sienne : un
+             * signal les arrête toutes.
+             * @param instance Instance de Signal à ajouter.
              */
             static void initSignalHandling(Signal *instance);
 
+            /**
+             * @brief Retire une instance avant sa destruction.
+             * @param instance Instance de Signal à retirer.
+             */
+            static void releaseSignalHandling(Signal *instance);
+
             /**
              * @brief Wrapper statique pour gérer les signaux.
              * @param sig Signal reçu.
@@ -79,7 +91,26 @@ namespace zappy {
            private:
             server::Server &_server;   ///< Référence au serveur.
             game::Game &_game;         ///< Référence au jeu.
-            static Signal *_instance;  ///< Instance statique pour le handler.
+            static std::vector<Signal *> _instances;  ///< Instances du handler.
+            static std::mutex _instancesLock;         ///< Protège _instances.
+
+            /**
+             * @brief Affiche le signal reçu et les statistiques du processus.
+             * @param sig Signal reçu.
+             */
+            static void _printShutdown(int sig);
+
+            /**
+             * @brief Modifie _instances, SIGINT et SIGTERM bloqués pour que
+             * le handler ne puisse pas attendre le verrou sur ce thread.
+             * @param update Modification à appliquer.
+             */
+            static void _updateInstances(const std::function<void()> &update);
+
+            /**
+             * @brief Arrête le serveur et le jeu de cette instance.
+             */
+            void _stop();
         };
 
         /**